@@ -0,0 +1,86 @@
+#include "HyperECS.h"
+
+#include "Check.h"
+
+#include <string>
+#include <vector>
+
+using HyperECSTests::Check;
+
+/* Component every entity gets */
+struct Position
+{
+	float X, Y;
+};
+
+/* Component every second entity gets */
+struct Velocity
+{
+	float X, Y;
+};
+
+/* Component that is not trivially copyable, so moving rows between archetypes has to call its constructors */
+struct Name
+{
+	std::string Value;
+};
+
+/**
+ * @brief Moving entities between archetypes and checking that components survive every move
+ *
+ * @return Returns the exit code
+ */
+int main()
+{
+	HyperECS::ArchetypeRegistry registry;
+
+	std::vector<HyperECS::Entity> entities;
+	for (size_t index = 0; index < 5000; index++)
+	{
+		HyperECS::Entity entity = registry.Construct();
+		registry.AddComponent<Position>(entity, Position{ static_cast<float>(index), 1.0f });
+		if (index % 2 == 0)
+			registry.AddComponent<Velocity>(entity, Velocity{ 2.0f, static_cast<float>(index) });
+		if (index % 3 == 0)
+			registry.AddComponent<Name>(entity, Name{ std::string(32, static_cast<char>('a' + index % 26)) });
+		entities.push_back(entity);
+	}
+
+	size_t moving = 0;
+	registry.Each<Position, Velocity>([&](HyperECS::Entity entity, Position& position, Velocity& velocity)
+	{
+		Check(position.X == velocity.Y, "Components of a row do not belong to the same entity!");
+		Check(entity == entities[static_cast<size_t>(position.X)], "Row belongs to another entity!");
+		position.X += velocity.X;
+		moving++;
+	});
+	Check(moving == 2500, "Each visited the wrong amount of entities!");
+
+	for (size_t index = 0; index < entities.size(); index += 4)
+		registry.RemoveComponent<Velocity>(entities[index]);
+
+	for (size_t index = 0; index < entities.size(); index++)
+	{
+		HyperECS::Entity entity = entities[index];
+		float expected = static_cast<float>(index) + (index % 2 == 0 ? 2.0f : 0.0f);
+		Check(registry.GetComponent<Position>(entity).X == expected, "Position was lost while moving between archetypes!");
+		Check(registry.HasComponent<Velocity>(entity) == (index % 4 == 2), "Velocity differs after the removal!");
+		Check(registry.HasComponent<Name>(entity) == (index % 3 == 0), "Name differs after the removal!");
+		if (index % 3 == 0)
+			Check(registry.GetComponent<Name>(entity).Value == std::string(32, static_cast<char>('a' + index % 26)), "Name was lost while moving between archetypes!");
+	}
+
+	Check(registry.GetEntities<Position, Velocity>().size() == 1250, "GetEntities found the wrong amount of entities!");
+
+	HyperECS::Entity destroyed = entities[7];
+	registry.Destroy(destroyed);
+	Check(!registry.IsValid(destroyed), "Destroyed entity is still valid!");
+
+	HyperECS::Entity reused = registry.Construct();
+	Check(reused.GetIndex() == destroyed.GetIndex(), "Index of the destroyed entity was not reused!");
+	Check(!registry.IsValid(destroyed) && registry.IsValid(reused), "Stale handle is valid for the reused index!");
+	Check(!registry.HasComponent<Position>(reused), "Reused entity has the components of the destroyed one!");
+	Check(registry.GetEntities<Position>().size() == 4999, "Destroyed entity still has components!");
+
+	return HyperECSTests::Finish("ArchetypeRegistry");
+}
@@ -0,0 +1,30 @@
+#include "HyperECSBenchmark.h"
+
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * @brief Running the registry benchmarks
+ *
+ * Usage: HyperECSBenchmark [repetitions] [entity counts...], without entity counts 10000, 100000 and 1000000 entities are used.
+ *
+ * @param argc Amount of arguments
+ * @param argv The arguments
+ *
+ * @return Returns the exit code
+ */
+int main(int argc, char** argv)
+{
+	size_t repetitions = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5;
+
+	HyperECS::Benchmark benchmark(std::cout, repetitions);
+	if (argc <= 2)
+	{
+		benchmark.Run();
+		return 0;
+	}
+
+	for (int index = 2; index < argc; index++)
+		benchmark.Run(std::strtoull(argv[index], nullptr, 10));
+	return 0;
+}
@@ -0,0 +1,137 @@
+#include "HyperECS.h"
+
+#include "Check.h"
+
+#include <iterator>
+#include <vector>
+
+using HyperECSTests::Check;
+
+/* Observed component */
+struct Health
+{
+	int Value;
+};
+
+/* Component observers read and add */
+struct Speed
+{
+	double Value;
+};
+
+/**
+ * @brief Checking the added and changed ticks of components
+ */
+static void ChangeTicks()
+{
+	HyperECS::Registry registry;
+	std::vector<HyperECS::Entity> entities;
+	registry.Construct(10, std::back_inserter(entities));
+	for (HyperECS::Entity entity : entities)
+		registry.AddComponent<Health>(entity, 1);
+
+	uint64_t sinceTick = registry.AdvanceTick();
+	registry.AddComponent<Speed>(entities[0], 1.0);
+	registry.PatchComponent<Health>(entities[1]).Value = 2;
+	registry.PatchComponent<Health>(entities[2]).Value = 3;
+
+	size_t added = 0;
+	size_t changed = 0;
+	registry.EachAdded<Health>(sinceTick, [&](HyperECS::Entity, Health&) { added++; });
+	registry.EachChanged<Health>(sinceTick, [&](HyperECS::Entity, Health& health) { changed += health.Value > 1; });
+	Check(added == 0 && changed == 2, "Change ticks differ!");
+
+	size_t addedSpeed = 0;
+	registry.EachAdded<Speed>(sinceTick, [&](HyperECS::Entity, Speed&) { addedSpeed++; });
+	Check(addedSpeed == 1, "Added tick differs!");
+}
+
+/**
+ * @brief Checking the recorded removals of components
+ */
+static void RemovedComponents()
+{
+	HyperECS::Registry registry;
+	registry.TrackRemoved<Health>();
+
+	std::vector<HyperECS::Entity> entities;
+	registry.Construct(8, std::back_inserter(entities));
+	for (HyperECS::Entity entity : entities)
+		registry.AddComponent<Health>(entity, 1);
+
+	registry.RemoveComponent<Health>(entities[0]);
+	uint64_t sinceTick = registry.AdvanceTick();
+	registry.RemoveComponent<Health>(entities[1]);
+	registry.Destroy(entities[2]);
+	registry.AdvanceTick();
+	HyperECS::Registry destination;
+	registry.Migrate(entities[3], destination);
+
+	std::vector<HyperECS::Entity> removed;
+	registry.EachRemoved<Health>(sinceTick, [&](HyperECS::Entity entity) { removed.push_back(entity); });
+	Check(removed == std::vector<HyperECS::Entity>{ entities[1], entities[2], entities[3] }, "Removed components differ!");
+
+	size_t all = 0;
+	registry.EachRemoved<Health>(0, [&](HyperECS::Entity) { all++; });
+	Check(all == 4, "Removal before the tick is missing!");
+
+	registry.TrimRemoved<Health>(sinceTick + 1);
+	removed.clear();
+	registry.EachRemoved<Health>(0, [&](HyperECS::Entity entity) { removed.push_back(entity); });
+	Check(removed == std::vector<HyperECS::Entity>{ entities[3] }, "Trimmed removals differ!");
+}
+
+/**
+ * @brief Checking that removed observers see the entity alive when it is destroyed or moved
+ */
+static void RemovedObservers()
+{
+	HyperECS::Registry registry;
+	size_t removed = 0;
+	registry.Observe<Health>(HyperECS::ComponentEvent::Removed, [&](HyperECS::Registry& observed, HyperECS::Entity entity)
+	{
+		Check(observed.IsValid(entity), "Removed observer got a released entity!");
+		Check(!observed.HasComponent<Health>(entity), "Removed component is still present!");
+		if (!observed.HasComponent<Speed>(entity))
+			observed.AddComponent<Speed>(entity, 1.0);
+		removed++;
+	});
+
+	std::vector<HyperECS::Entity> entities;
+	registry.Construct(6, std::back_inserter(entities));
+	for (HyperECS::Entity entity : entities)
+		registry.AddComponent<Health>(entity, 1);
+	registry.SetParent(entities[1], entities[0]);
+
+	registry.RemoveComponent<Health>(entities[5]);
+	Check(registry.HasComponent<Speed>(entities[5]), "Observer did not run for a removed component!");
+
+	registry.Destroy(entities[0]);
+	registry.Destroy(std::span<const HyperECS::Entity>(entities.data() + 1, 2));
+	Check(removed == 4, "Removed observers were not notified!");
+	Check(registry.GetEntities<Speed>().size() == 1, "Component added by an observer outlived its entity!");
+	Check(registry.GetEntities().size() == 3, "Destroyed entities are still alive!");
+
+	HyperECS::Registry destination;
+	std::vector<HyperECS::Entity> migrated;
+	registry.Migrate(std::span<const HyperECS::Entity>(entities.data() + 3, 2), destination, std::back_inserter(migrated));
+	Check(removed == 6 && migrated.size() == 2, "Removed observers were not notified on migration!");
+	Check(registry.GetEntities<Speed>().size() == 1 && destination.GetEntities<Health>().size() == 2, "Moved components differ!");
+
+	for (size_t index = 0; index < 4; index++)
+		Check(registry.IsValid(registry.Construct()), "Free list was corrupted!");
+}
+
+/**
+ * @brief Checking change ticks and observers
+ *
+ * @return Returns the exit code
+ */
+int main()
+{
+	ChangeTicks();
+	RemovedComponents();
+	RemovedObservers();
+
+	return HyperECSTests::Finish("ChangeTracking");
+}
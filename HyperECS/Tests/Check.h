@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+
+namespace HyperECSTests
+{
+	/* Amount of failed checks of the test */
+	inline size_t s_Failures = 0;
+
+	/**
+	 * @brief Reporting a failed check, the checks stay active in release builds
+	 *
+	 * @param condition The condition that has to hold
+	 * @param message The message that is printed if the condition does not hold
+	 */
+	inline void Check(bool condition, const char* message)
+	{
+		if (condition)
+			return;
+
+		std::cerr << "[HyperECS] " << message << std::endl;
+		s_Failures++;
+	}
+
+	/**
+	 * @brief Reporting the result of the test
+	 *
+	 * @param name The name of the test
+	 *
+	 * @return Returns the exit code of the test
+	 */
+	inline int Finish(const char* name)
+	{
+		if (s_Failures != 0)
+		{
+			std::cerr << "[HyperECS] " << name << ": " << s_Failures << " checks failed!" << std::endl;
+			return 1;
+		}
+
+		std::cout << name << " passed" << std::endl;
+		return 0;
+	}
+}
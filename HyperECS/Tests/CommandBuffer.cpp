@@ -0,0 +1,112 @@
+#include "HyperECS.h"
+
+#include "Check.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using HyperECSTests::Check;
+
+/* Component recorded for constructed and existing entities */
+struct Health
+{
+	int Value;
+};
+
+/* Second component, removed and added through the buffer */
+struct Speed
+{
+	double Value;
+};
+
+/* Move only component, added to many entities in one batch */
+struct Payload
+{
+	std::unique_ptr<int> Value;
+};
+
+/**
+ * @brief Recording changes for placeholders and existing entities, also from multiple threads, and playing them back
+ *
+ * @return Returns the exit code
+ */
+int main()
+{
+	HyperECS::Registry registry;
+	HyperECS::Entity existing = registry.Construct();
+	registry.AddComponent<Health>(existing, 10);
+	HyperECS::Entity doomed = registry.Construct();
+	registry.AddComponent<Speed>(doomed, 1.0);
+
+	HyperECS::CommandBuffer commands;
+	HyperECS::Entity first = commands.Construct();
+	HyperECS::Entity second = commands.Construct();
+	commands.AddComponent<Health>(first, 1);
+	commands.AddComponent<Speed>(first, 2.0);
+	commands.AddComponent<Health>(second, 3);
+	commands.RemoveComponent<Health>(existing);
+	commands.AddComponent<Speed>(existing, 4.0);
+	commands.Destroy(doomed);
+	Check(!commands.IsEmpty(), "Buffer is empty after recording!");
+
+	commands.Playback(registry);
+	Check(commands.IsEmpty(), "Buffer is not empty after the playback!");
+	Check(!registry.IsValid(doomed), "Destroyed entity is still valid!");
+	Check(!registry.HasComponent<Health>(existing) && registry.GetComponent<Speed>(existing).Value == 4.0, "Changes of the existing entity were not applied!");
+
+	std::vector<HyperECS::Entity> constructed = registry.GetEntities<Health>();
+	Check(constructed.size() == 2, "Placeholders were not constructed!");
+
+	int healthSum = 0;
+	size_t speedCount = 0;
+	registry.Each<Health>([&](HyperECS::Entity entity, Health& health)
+	{
+		healthSum += health.Value;
+		if (registry.HasComponent<Speed>(entity))
+		{
+			Check(health.Value == 1 && registry.GetComponent<Speed>(entity).Value == 2.0, "Components of a placeholder ended on another entity!");
+			speedCount++;
+		}
+	});
+	Check(healthSum == 4 && speedCount == 1, "Components of the placeholders differ!");
+
+	std::vector<std::thread> threads;
+	for (int thread = 0; thread < 4; thread++)
+		threads.emplace_back([&commands, thread]()
+		{
+			for (int index = 0; index < 250; index++)
+			{
+				HyperECS::Entity entity = commands.Construct();
+				commands.AddComponent<Health>(entity, thread * 1000 + index);
+			}
+		});
+	for (std::thread& thread : threads)
+		thread.join();
+
+	commands.Playback(registry);
+	Check(registry.GetEntities<Health>().size() == 1002, "Placeholders recorded from multiple threads were lost!");
+
+	long long threadSum = 0;
+	registry.Each<Health>([&](HyperECS::Entity, Health& health) { threadSum += health.Value; });
+	Check(threadSum == 4 + (0 + 1000 + 2000 + 3000) * 250LL + 4 * (249 * 250 / 2), "Components recorded from multiple threads differ!");
+
+	std::vector<HyperECS::Entity> placeholders;
+	for (int index = 0; index < 100; index++)
+	{
+		placeholders.push_back(commands.Construct());
+		commands.AddComponent<Payload>(placeholders.back(), std::make_unique<int>(index));
+		commands.AddComponent<Speed>(placeholders.back(), static_cast<double>(index));
+	}
+	commands.Playback(registry);
+
+	size_t payloadCount = 0;
+	registry.Each<Payload>([&](HyperECS::Entity entity, Payload& payload)
+	{
+		Check(payload.Value && registry.GetComponent<Speed>(entity).Value == *payload.Value, "Batched components ended on another entity!");
+		payloadCount++;
+	});
+	Check(payloadCount == 100, "Batched components were lost!");
+
+	return HyperECSTests::Finish("CommandBuffer");
+}
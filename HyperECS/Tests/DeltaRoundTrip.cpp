@@ -0,0 +1,267 @@
+#include "HyperECS.h"
+
+#include "Check.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using HyperECSTests::Check;
+
+/* Trivially copyable component */
+struct Health
+{
+	int Value;
+};
+
+/* Second trivially copyable component, grouped with the health */
+struct Speed
+{
+	double Value;
+};
+
+/* Component with a custom serialization */
+struct Name
+{
+	std::string Value;
+};
+
+/* Component stored as struct of arrays */
+struct Position
+{
+	float X;
+	int Y;
+};
+
+template<>
+struct HyperECS::ComponentTraits<Name>
+{
+	static void Serialize(std::ostream& stream, const Name& name)
+	{
+		uint64_t size = name.Value.size();
+		stream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+		stream.write(name.Value.data(), static_cast<std::streamsize>(size));
+	}
+
+	static Name Deserialize(std::istream& stream)
+	{
+		uint64_t size = 0;
+		stream.read(reinterpret_cast<char*>(&size), sizeof(size));
+		std::string value(size, '\0');
+		stream.read(value.data(), static_cast<std::streamsize>(size));
+		return Name{ value };
+	}
+};
+
+template<>
+struct HyperECS::ComponentTraits<Position>
+{
+	static constexpr auto Fields = std::make_tuple(&Position::X, &Position::Y);
+};
+
+/**
+ * @brief Comparing the component of a class of an entity in two registries
+ *
+ * @tparam T The component class
+ * @tparam Equal The type of the comparison
+ * @param sender The registry the deltas are written from
+ * @param receiver The registry the deltas are applied to
+ * @param entity The entity that is compared
+ * @param equal Function that compares two components
+ */
+template<class T, class Equal>
+static void CompareComponent(HyperECS::Registry& sender, HyperECS::Registry& receiver, HyperECS::Entity entity, Equal&& equal)
+{
+	bool hasComponent = sender.HasComponent<T>(entity);
+	Check(hasComponent == receiver.HasComponent<T>(entity), "Component differs in presence!");
+	if (hasComponent && receiver.HasComponent<T>(entity))
+		Check(equal(T(sender.GetComponent<T>(entity)), T(receiver.GetComponent<T>(entity))), "Component differs in value!");
+}
+
+/**
+ * @brief Comparing the entities, components, ticks, groups and parents of two registries
+ *
+ * @param sender The registry the deltas are written from
+ * @param receiver The registry the deltas are applied to
+ */
+static void Compare(HyperECS::Registry& sender, HyperECS::Registry& receiver)
+{
+	std::vector<HyperECS::Entity> entities = sender.GetEntities();
+	Check(entities == receiver.GetEntities(), "Entities differ!");
+	Check(sender.GetTick() == receiver.GetTick(), "Tick differs!");
+	if (entities != receiver.GetEntities())
+		return;
+
+	for (HyperECS::Entity entity : entities)
+	{
+		CompareComponent<Health>(sender, receiver, entity, [](const Health& left, const Health& right) { return left.Value == right.Value; });
+		CompareComponent<Speed>(sender, receiver, entity, [](const Speed& left, const Speed& right) { return left.Value == right.Value; });
+		CompareComponent<Name>(sender, receiver, entity, [](const Name& left, const Name& right) { return left.Value == right.Value; });
+		CompareComponent<Position>(sender, receiver, entity, [](const Position& left, const Position& right) { return left.X == right.X && left.Y == right.Y; });
+		Check(sender.GetParent(entity) == receiver.GetParent(entity), "Parent differs!");
+	}
+
+	Check(sender.GetGroup<Health, Speed>().Size() == receiver.GetGroup<Health, Speed>().Size(), "Group differs!");
+
+	size_t senderChanged = 0;
+	size_t receiverChanged = 0;
+	sender.EachChanged<Health>(sender.GetTick(), [&](HyperECS::Entity, Health&) { senderChanged++; });
+	receiver.EachChanged<Health>(receiver.GetTick(), [&](HyperECS::Entity, Health&) { receiverChanged++; });
+	Check(senderChanged == receiverChanged, "Change ticks differ!");
+}
+
+/**
+ * @brief Applying random changes to a registry
+ *
+ * @param registry The registry that is changed
+ * @param entities The alive entities of the registry
+ * @param random The random generator
+ * @param count Amount of changes
+ */
+static void Mutate(HyperECS::Registry& registry, std::vector<HyperECS::Entity>& entities, std::mt19937& random, size_t count)
+{
+	for (size_t index = 0; index < count; index++)
+	{
+		uint32_t operation = random() % 9;
+		if (operation == 0 || entities.empty())
+		{
+			entities.push_back(registry.Construct());
+			continue;
+		}
+
+		HyperECS::Entity entity = entities[random() % entities.size()];
+		switch (operation)
+		{
+		case 1:
+			entities.erase(std::find(entities.begin(), entities.end(), entity));
+			registry.Destroy(entity);
+			break;
+		case 2:
+			if (!registry.HasComponent<Health>(entity))
+				registry.AddComponent<Health>(entity, static_cast<int>(random() % 100));
+			else
+				registry.PatchComponent<Health>(entity).Value++;
+			break;
+		case 3:
+			if (registry.HasComponent<Health>(entity))
+				registry.RemoveComponent<Health>(entity);
+			break;
+		case 4:
+			if (!registry.HasComponent<Speed>(entity))
+				registry.AddComponent<Speed>(entity, random() * 0.5);
+			else
+				registry.RemoveComponent<Speed>(entity);
+			break;
+		case 5:
+			if (!registry.HasComponent<Name>(entity))
+				registry.AddComponent<Name>(entity, std::string(random() % 30, 'x'));
+			else
+				registry.PatchComponent<Name>(entity).Value += "y";
+			break;
+		case 6:
+		{
+			HyperECS::Entity parent = entities[random() % entities.size()];
+			if (!(parent == entity) && !registry.GetHierarchy().IsAncestor(entity, parent))
+				registry.SetParent(entity, parent);
+			break;
+		}
+		case 7:
+			registry.RemoveParent(entity);
+			break;
+		case 8:
+			if (!registry.HasComponent<Position>(entity))
+				registry.AddComponent<Position>(entity, Position{ 1.0f, 2 });
+			else if (random() % 2)
+				registry.RemoveComponent<Position>(entity);
+			else
+				registry.PatchComponent<Position>(entity) = Position{ static_cast<float>(random() % 7), static_cast<int>(random() % 9) };
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Registering the component classes of the test
+ *
+ * @param registry The registry the classes are registered in
+ */
+static void Register(HyperECS::Registry& registry)
+{
+	registry.Register<Health>();
+	registry.Register<Speed>();
+	registry.Register<Name>();
+	registry.Register<Position>();
+}
+
+/**
+ * @brief Applying a delta of a registry with fewer entity indices, the entities beyond them lose their components
+ */
+static void ShrinkingDelta()
+{
+	HyperECS::Registry sender;
+	HyperECS::Registry receiver;
+	Register(sender);
+	Register(receiver);
+
+	std::vector<HyperECS::Entity> sent;
+	std::vector<HyperECS::Entity> received;
+	sender.Construct(3, std::back_inserter(sent));
+	receiver.Construct(10, std::back_inserter(received));
+	for (HyperECS::Entity entity : sent)
+		sender.AddComponent<Health>(entity, 1);
+	for (HyperECS::Entity entity : received)
+		receiver.AddComponent<Health>(entity, 2);
+	receiver.SetParent(received[1], received[9]);
+
+	std::stringstream delta;
+	sender.SaveDelta(delta, 0);
+	receiver.LoadDelta(delta);
+	Check(receiver.GetEntities().size() == 3 && receiver.GetEntities<Health>().size() == 3, "Entities cut off by the delta kept their components!");
+	Check(!receiver.GetParent(received[1]).IsHandleValid(), "Child kept a parent that was cut off by the delta!");
+	Check(sender.Construct() == receiver.Construct(), "Free list differs after a shrinking delta!");
+}
+
+/**
+ * @brief Applying every delta of a randomly changed registry to a second registry and comparing both after every tick
+ *
+ * @return Returns the exit code
+ */
+int main()
+{
+	HyperECS::Registry sender;
+	Register(sender);
+
+	std::mt19937 random(1);
+	std::vector<HyperECS::Entity> entities;
+	Mutate(sender, entities, random, 300);
+
+	std::stringstream snapshot;
+	sender.Save(snapshot);
+
+	HyperECS::Registry receiver;
+	Register(receiver);
+	receiver.Load(snapshot);
+	Compare(sender, receiver);
+
+	for (size_t round = 0; round < 200; round++)
+	{
+		uint64_t sinceTick = sender.AdvanceTick();
+		Mutate(sender, entities, random, random() % 40);
+
+		std::stringstream delta;
+		sender.SaveDelta(delta, sinceTick);
+		receiver.LoadDelta(delta);
+		Compare(sender, receiver);
+	}
+
+	for (size_t index = 0; index < 5; index++)
+		Check(sender.Construct() == receiver.Construct(), "Free list differs!");
+
+	ShrinkingDelta();
+
+	return HyperECSTests::Finish("DeltaRoundTrip");
+}
@@ -0,0 +1,208 @@
+#include "HyperECS.h"
+
+#include "Check.h"
+
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <random>
+#include <span>
+#include <sstream>
+#include <vector>
+
+using HyperECSTests::Check;
+
+/* Field component stored as struct of arrays */
+struct Position
+{
+	float X, Y, Z;
+};
+
+/* Second field component, iterated together with the position */
+struct Velocity
+{
+	float X, Y, Z;
+};
+
+/* Plain component stored as array of structs */
+struct Tag
+{
+	int Value;
+};
+
+template<>
+struct HyperECS::ComponentTraits<Position>
+{
+	static constexpr auto Fields = std::make_tuple(&Position::X, &Position::Y, &Position::Z);
+};
+
+template<>
+struct HyperECS::ComponentTraits<Velocity>
+{
+	static constexpr auto Fields = std::make_tuple(&Velocity::X, &Velocity::Y, &Velocity::Z);
+};
+
+static_assert(HyperECS::FieldComponent<Position> && !HyperECS::FieldComponent<Tag>);
+
+/**
+ * @brief Moving every position by its velocity through the field spans
+ *
+ * @param registry The registry that stores the components
+ * @param deltaTime The time step
+ */
+static void Integrate(HyperECS::Registry& registry, float deltaTime)
+{
+	registry.EachFields<Position, Velocity>([deltaTime](std::span<const HyperECS::Entity> entities, HyperECS::FieldSpans<Position> positions, HyperECS::FieldSpans<Velocity> velocities)
+	{
+		std::span<float> positionX = positions.Get<&Position::X>();
+		std::span<float> positionY = positions.Get<&Position::Y>();
+		std::span<float> positionZ = positions.Get<&Position::Z>();
+		std::span<float> velocityX = velocities.Get<&Velocity::X>();
+		std::span<float> velocityY = velocities.Get<&Velocity::Y>();
+		std::span<float> velocityZ = velocities.Get<&Velocity::Z>();
+		Check(reinterpret_cast<uintptr_t>(positionX.data()) % 64 == 0 && reinterpret_cast<uintptr_t>(velocityZ.data()) % 64 == 0, "Field array is not aligned to a cache line!");
+		Check(positionX.size() == entities.size() && velocityZ.size() == entities.size(), "Field spans differ from the entities!");
+
+		for (size_t index = 0; index < entities.size(); index++)
+		{
+			positionX[index] += velocityX[index] * deltaTime;
+			positionY[index] += velocityY[index] * deltaTime;
+			positionZ[index] += velocityZ[index] * deltaTime;
+		}
+	});
+}
+
+/**
+ * @brief Comparing two positions
+ *
+ * @param left The first position
+ * @param right The second position
+ *
+ * @return Returns true if all fields are equal
+ */
+static bool Equal(const Position& left, const Position& right)
+{
+	return left.X == right.X && left.Y == right.Y && left.Z == right.Z;
+}
+
+/**
+ * @brief Iterating, patching, saving and recording field components and comparing them with a reference
+ *
+ * @return Returns the exit code
+ */
+int main()
+{
+	HyperECS::Registry registry;
+	std::vector<HyperECS::Entity> entities;
+	registry.Construct(5000, std::back_inserter(entities));
+
+	std::mt19937 random(3);
+	std::map<uint64_t, Position> positions;
+	std::map<uint64_t, Velocity> velocities;
+	for (size_t index = 0; index < entities.size(); index++)
+	{
+		HyperECS::Entity entity = entities[index];
+		if (random() % 4)
+		{
+			Position position{ static_cast<float>(index), static_cast<float>(2 * index), static_cast<float>(3 * index) };
+			HyperECS::FieldReference<Position> reference = registry.AddComponent<Position>(entity, position.X, position.Y, position.Z);
+			Check(reference.Get<&Position::Y>() == position.Y, "Added field differs!");
+			positions[entity.Handle] = position;
+		}
+
+		if (random() % 3)
+		{
+			Velocity velocity{ 1.0f, static_cast<float>(index % 7), -1.0f };
+			registry.AddComponent<Velocity>(entity, velocity);
+			velocities[entity.Handle] = velocity;
+		}
+
+		if (index % 5 == 0)
+			registry.AddComponent<Tag>(entity, static_cast<int>(index));
+	}
+
+	for (size_t index = 0; index < 300; index++)
+	{
+		HyperECS::Entity entity = entities[random() % entities.size()];
+		if (registry.HasComponent<Velocity>(entity))
+		{
+			registry.RemoveComponent<Velocity>(entity);
+			velocities.erase(entity.Handle);
+		}
+	}
+
+	for (size_t index = 0; index < 100; index++)
+	{
+		HyperECS::Entity entity = entities[random() % entities.size()];
+		if (!registry.IsValid(entity))
+			continue;
+
+		registry.Destroy(entity);
+		positions.erase(entity.Handle);
+		velocities.erase(entity.Handle);
+	}
+
+	for (size_t step = 0; step < 3; step++)
+	{
+		Integrate(registry, 0.5f);
+		for (auto& [handle, position] : positions)
+		{
+			auto iterator = velocities.find(handle);
+			if (iterator == velocities.end())
+				continue;
+
+			position.X += iterator->second.X * 0.5f;
+			position.Y += iterator->second.Y * 0.5f;
+			position.Z += iterator->second.Z * 0.5f;
+		}
+
+		HyperECS::Entity entity = registry.Construct();
+		registry.AddComponent<Position>(entity, 0.0f, 0.0f, 0.0f);
+		registry.AddComponent<Velocity>(entity, 1.0f, 1.0f, 1.0f);
+		positions[entity.Handle] = Position{ 0.0f, 0.0f, 0.0f };
+		velocities[entity.Handle] = Velocity{ 1.0f, 1.0f, 1.0f };
+	}
+
+	for (const auto& [handle, position] : positions)
+		Check(Equal(registry.GetComponent<Position>(HyperECS::Entity{ handle }), position), "Integrated position differs!");
+
+	size_t velocityCount = 0;
+	registry.Each<Velocity>([&](HyperECS::Entity entity, HyperECS::FieldReference<Velocity> reference)
+	{
+		Velocity velocity = reference;
+		Check(velocity.Y == velocities[entity.Handle].Y, "Velocity differs!");
+		velocityCount++;
+	});
+	Check(velocityCount == velocities.size(), "Velocities are missing!");
+
+	for (auto [entity, position, tag] : registry.View<Position, Tag>())
+		Check(Position(position).X == positions[entity.Handle].X && tag.Value % 5 == 0, "View differs!");
+
+	HyperECS::Entity patched{ positions.begin()->first };
+	registry.PatchComponent<Position>(patched) = Position{ 9.0f, 8.0f, 7.0f };
+	positions[patched.Handle] = Position{ 9.0f, 8.0f, 7.0f };
+	Check(registry.GetComponent<Position>(patched).Get<&Position::Z>() == 7.0f, "Patched field differs!");
+
+	registry.EachFields<Position>([&](std::span<const HyperECS::Entity> spanEntities, HyperECS::FieldSpans<Position> spans)
+	{
+		Check(spanEntities.size() == positions.size() && spans.Size() == positions.size(), "Single field spans differ!");
+	});
+
+	std::stringstream snapshot;
+	registry.Save(snapshot);
+	HyperECS::Registry loaded;
+	loaded.Register<Position>();
+	loaded.Register<Velocity>();
+	loaded.Register<Tag>();
+	loaded.Load(snapshot);
+	for (const auto& [handle, position] : positions)
+		Check(Equal(loaded.GetComponent<Position>(HyperECS::Entity{ handle }), position), "Loaded position differs!");
+
+	HyperECS::CommandBuffer commands;
+	HyperECS::Entity placeholder = commands.Construct();
+	commands.AddComponent<Position>(placeholder, Position{ 1.0f, 2.0f, 3.0f });
+	commands.Playback(loaded);
+	Check(loaded.GetEntities<Position>().size() == positions.size() + 1, "Recorded field component is missing!");
+
+	return HyperECSTests::Finish("FieldComponents");
+}
@@ -0,0 +1,201 @@
+#include "HyperECS.h"
+
+#include "Check.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+using HyperECSTests::Check;
+
+/* Transform relative to the parent */
+struct Local
+{
+	float Value;
+};
+
+/* Transform accumulated over all ancestors */
+struct Global
+{
+	float Value;
+};
+
+/* Reference of the parent handle of every child */
+using Parents = std::map<uint64_t, uint64_t>;
+
+/**
+ * @brief Checking whether an entity is an ancestor of another entity in the reference
+ *
+ * @param parents The reference relations
+ * @param ancestor The possible ancestor
+ * @param entity The entity whose ancestors are searched
+ *
+ * @return Returns true if the entity is a descendant of the ancestor
+ */
+static bool IsAncestor(const Parents& parents, HyperECS::Entity ancestor, HyperECS::Entity entity)
+{
+	for (auto iterator = parents.find(entity.Handle); iterator != parents.end(); iterator = parents.find(iterator->second))
+	{
+		if (iterator->second == ancestor.Handle)
+			return true;
+	}
+
+	return false;
+}
+
+/**
+ * @brief Comparing the order and the levels of the hierarchy with the reference
+ *
+ * @param registry The registry that stores the hierarchy
+ * @param parents The reference relations
+ */
+static void CompareHierarchy(HyperECS::Registry& registry, const Parents& parents)
+{
+	std::map<uint64_t, size_t> positions;
+	registry.EachHierarchy([&](HyperECS::Entity entity, HyperECS::Entity parent)
+	{
+		if (parent.IsHandleValid())
+		{
+			auto iterator = parents.find(entity.Handle);
+			Check(positions.contains(parent.Handle), "Child is visited before its parent!");
+			Check(iterator != parents.end() && iterator->second == parent.Handle, "Visited parent differs!");
+		}
+		else
+			Check(!parents.contains(entity.Handle), "Child is visited as a root!");
+
+		positions[entity.Handle] = positions.size();
+	});
+
+	std::set<uint64_t> participants;
+	for (const auto& [child, parent] : parents)
+	{
+		participants.insert(child);
+		participants.insert(parent);
+		Check(registry.GetParent(HyperECS::Entity{ child }).Handle == parent, "Parent differs!");
+	}
+
+	Check(participants.size() == positions.size(), "Hierarchy contains other entities than the relations!");
+
+	const HyperECS::Hierarchy& hierarchy = registry.GetHierarchy();
+	size_t total = 0;
+	for (size_t depth = 0; depth < hierarchy.GetLevelCount(); depth++)
+	{
+		std::pair<size_t, size_t> level = hierarchy.GetLevel(depth);
+		total += level.second - level.first;
+		for (size_t index = level.first; index < level.second; index++)
+		{
+			size_t parentIndex = hierarchy.GetParentIndices()[index];
+			if (depth == 0)
+				Check(parentIndex == HyperECS::Hierarchy::Null, "Root has a parent index!");
+			else
+				Check(parentIndex >= hierarchy.GetLevel(depth - 1).first && parentIndex < hierarchy.GetLevel(depth - 1).second, "Parent is not on the previous level!");
+		}
+	}
+
+	Check(total == positions.size(), "Levels differ from the visited entities!");
+}
+
+/**
+ * @brief Changing the hierarchy randomly, comparing it with a reference and propagating transforms in parallel
+ *
+ * @return Returns the exit code
+ */
+int main()
+{
+	HyperECS::Registry registry;
+	std::vector<HyperECS::Entity> entities;
+	registry.Construct(2000, std::back_inserter(entities));
+
+	std::mt19937 random(7);
+	Parents parents;
+	for (size_t step = 0; step < 20000; step++)
+	{
+		HyperECS::Entity child = entities[random() % entities.size()];
+		HyperECS::Entity parent = entities[random() % entities.size()];
+		uint32_t operation = random() % 10;
+		if (operation < 7)
+		{
+			if (child == parent || IsAncestor(parents, child, parent))
+				continue;
+
+			registry.SetParent(child, parent);
+			parents[child.Handle] = parent.Handle;
+		}
+		else if (operation < 9)
+		{
+			registry.RemoveParent(child);
+			parents.erase(child.Handle);
+		}
+		else
+		{
+			registry.Destroy(child);
+			parents.erase(child.Handle);
+			std::erase_if(parents, [&](const auto& relation) { return relation.second == child.Handle; });
+			entities.erase(std::find(entities.begin(), entities.end(), child));
+			entities.push_back(registry.Construct());
+		}
+
+		if (step % 1000 == 0)
+			CompareHierarchy(registry, parents);
+	}
+
+	CompareHierarchy(registry, parents);
+
+	for (HyperECS::Entity entity : entities)
+	{
+		registry.AddComponent<Local>(entity, static_cast<float>(random() % 10));
+		registry.AddComponent<Global>(entity, 0.0f);
+	}
+
+	registry.ParallelEachHierarchy([&](HyperECS::Entity entity, HyperECS::Entity parent)
+	{
+		float value = registry.GetComponent<Local>(entity).Value;
+		if (parent.IsHandleValid())
+			value += registry.GetComponent<Global>(parent).Value;
+
+		registry.GetComponent<Global>(entity).Value = value;
+	}, 8);
+
+	for (const auto& [child, parent] : parents)
+	{
+		float expected = 0.0f;
+		for (uint64_t handle = child;;)
+		{
+			expected += registry.GetComponent<Local>(HyperECS::Entity{ handle }).Value;
+			auto iterator = parents.find(handle);
+			if (iterator == parents.end())
+				break;
+
+			handle = iterator->second;
+		}
+
+		Check(registry.GetComponent<Global>(HyperECS::Entity{ child }).Value == expected, "Transform was not propagated from the parent!");
+	}
+
+	HyperECS::Entity parent{ parents.begin()->second };
+	size_t children = 0;
+	registry.EachChild(parent, [&](HyperECS::Entity child)
+	{
+		Check(parents[child.Handle] == parent.Handle, "Child has another parent!");
+		children++;
+	});
+	Check(children == static_cast<size_t>(std::count_if(parents.begin(), parents.end(), [&](const auto& relation) { return relation.second == parent.Handle; })), "Children are missing!");
+
+	registry.Register<Local>();
+	registry.Register<Global>();
+	std::stringstream snapshot;
+	registry.Save(snapshot);
+
+	HyperECS::Registry loaded;
+	loaded.Register<Local>();
+	loaded.Register<Global>();
+	loaded.Load(snapshot);
+	CompareHierarchy(loaded, parents);
+
+	return HyperECSTests::Finish("Hierarchy");
+}
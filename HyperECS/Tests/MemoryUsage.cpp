@@ -0,0 +1,95 @@
+#include "HyperECS.h"
+
+#include "Check.h"
+
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using HyperECSTests::Check;
+
+/* Large trivially copyable component */
+struct Transform
+{
+	double Values[4];
+};
+
+/* Small component on half of the entities */
+struct Health
+{
+	int Value;
+};
+
+/* Field component stored as struct of arrays */
+struct Position
+{
+	float X;
+	int Y;
+};
+
+template<>
+struct HyperECS::ComponentTraits<Position>
+{
+	static constexpr auto Fields = std::make_tuple(&Position::X, &Position::Y);
+};
+
+/**
+ * @brief Measuring the memory of a world and writing it to a file
+ *
+ * @return Returns the exit code
+ */
+int main()
+{
+	HyperECS::World world;
+	std::vector<HyperECS::Entity> entities;
+	world.Construct(1000, std::back_inserter(entities));
+	for (size_t index = 0; index < entities.size(); index++)
+	{
+		world.AddComponent<Transform>(entities[index]);
+		if (index % 2)
+			world.AddComponent<Health>(entities[index], 1);
+		if (index % 4 == 0)
+			world.AddComponent<Position>(entities[index], Position{ 1.0f, 2 });
+	}
+
+	world.Destroy(std::span<const HyperECS::Entity>(entities.data(), 100));
+	world.Each<Transform, Health>([](HyperECS::Entity, Transform&, Health&) {});
+	world.SetParent(entities[101], entities[100]);
+
+	HyperECS::MemoryUsage memory = world.GetMemoryUsage();
+	Check(memory.EntityCount == 900 && memory.FreeEntityCount == 100, "Entity counts differ!");
+	Check(memory.FreeEntityBytes == 100 * sizeof(HyperECS::Entity), "Free entity bytes differ!");
+	Check(memory.Components.size() == 3, "Component pools are missing!");
+
+	Check(memory.EntityTickBytes >= 1000 * sizeof(uint64_t) && memory.GroupBytes >= 450 * sizeof(HyperECS::Entity) && memory.HierarchyBytes >= 2 * sizeof(HyperECS::Entity), "Entity ticks, groups or the hierarchy are not counted!");
+
+	size_t total = memory.EntityBytes + memory.EntityTickBytes + memory.GroupBytes + memory.HierarchyBytes;
+	for (const HyperECS::ComponentMemory& component : memory.Components)
+	{
+		total += component.UsedBytes + component.UnusedBytes + component.SparseBytes;
+		Check(component.Capacity >= component.Count, "Capacity is below the count!");
+		if (component.Name == "Transform")
+			Check(component.Count == 900 && component.UsedBytes == 900 * (sizeof(Transform) + sizeof(HyperECS::Entity) + 2 * sizeof(uint64_t)), "Component bytes differ!");
+		if (component.Name == "Position")
+			Check(component.Count == 225 && component.UsedBytes == 225 * (sizeof(float) + sizeof(int) + sizeof(HyperECS::Entity) + 2 * sizeof(uint64_t)), "Field component bytes differ!");
+	}
+
+	Check(total == memory.TotalBytes, "Total bytes differ from the sum of the parts!");
+	Check(memory.BytesPerEntity == static_cast<double>(memory.TotalBytes) / 900.0, "Bytes per entity differ!");
+
+	Check(world.DumpMemoryUsage("MemoryUsage.json"), "Memory usage was not written!");
+	Check(!world.DumpMemoryUsage("Missing/MemoryUsage.json"), "Writing to a missing directory succeeded!");
+
+	std::ifstream file("MemoryUsage.json");
+	std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	Check(json.starts_with("{\"entities\":900,") && json.find("\"name\":\"Transform\"") != std::string::npos, "Written memory usage differs!");
+
+	std::ostringstream escaped;
+	HyperECS::WriteJsonString(escaped, "A<\"B\\C\">\n");
+	Check(escaped.str() == "\"A<\\\"B\\\\C\\\">\\u000a\"", "Name was not escaped!");
+
+	return HyperECSTests::Finish("MemoryUsage");
+}
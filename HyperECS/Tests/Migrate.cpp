@@ -0,0 +1,199 @@
+#include "HyperECS.h"
+
+#include "Check.h"
+
+#include <iterator>
+#include <span>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using HyperECSTests::Check;
+
+/* Component every migrated entity has */
+struct Health
+{
+	int Value;
+};
+
+/* Component grouped with the health */
+struct Speed
+{
+	int Value;
+};
+
+/* Component with a non trivial member */
+struct Name
+{
+	std::string Value;
+};
+
+/* Field component stored as struct of arrays */
+struct Position
+{
+	float X;
+	int Y;
+};
+
+/* Component only registered in the source of a snapshot */
+struct Score
+{
+	int Value;
+};
+
+template<>
+struct HyperECS::ComponentTraits<Position>
+{
+	static constexpr auto Fields = std::make_tuple(&Position::X, &Position::Y);
+};
+
+/**
+ * @brief Moving entities with their components, groups and hierarchy between registries and merging registries
+ */
+static void MigrateEntities()
+{
+	HyperECS::Registry source;
+	HyperECS::Registry destination;
+
+	size_t removed = 0;
+	size_t added = 0;
+	source.Observe<Health>(HyperECS::ComponentEvent::Removed, [&](HyperECS::Registry&, HyperECS::Entity) { removed++; });
+	destination.Observe<Health>(HyperECS::ComponentEvent::Added, [&](HyperECS::Registry&, HyperECS::Entity) { added++; });
+
+	HyperECS::Entity existing = destination.Construct();
+	destination.AddComponent<Health>(existing, 99);
+	destination.AddComponent<Speed>(existing, 98);
+	HyperECS::Group& group = destination.GetGroup<Health, Speed>();
+
+	std::vector<HyperECS::Entity> entities;
+	source.Construct(100, std::back_inserter(entities));
+	for (int index = 0; index < 100; index++)
+	{
+		source.AddComponent<Health>(entities[index], index);
+		if (index % 2)
+			source.AddComponent<Speed>(entities[index], -index);
+		if (index % 3 == 0)
+			source.AddComponent<Name>(entities[index], std::string(40, static_cast<char>('a' + index % 26)));
+		if (index % 5 == 0)
+			source.AddComponent<Position>(entities[index], Position{ static_cast<float>(index), index * 2 });
+	}
+
+	source.SetParent(entities[1], entities[0]);
+	source.SetParent(entities[2], entities[1]);
+	source.SetParent(entities[3], entities[50]);
+	source.SetParent(entities[51], entities[3]);
+
+	destination.AdvanceTick();
+	uint64_t sinceTick = destination.AdvanceTick();
+
+	std::vector<HyperECS::Entity> moved(entities.begin(), entities.begin() + 10);
+	std::vector<HyperECS::Entity> migrated;
+	source.Migrate(moved, destination, std::back_inserter(migrated));
+	Check(migrated.size() == moved.size(), "Migrated entities are missing!");
+
+	for (int index = 0; index < 10; index++)
+	{
+		HyperECS::Entity entity = migrated[index];
+		Check(!source.IsValid(entities[index]) && destination.IsValid(entity), "Entity was not moved!");
+		Check(destination.GetComponent<Health>(entity).Value == index, "Moved component differs!");
+		Check(destination.HasComponent<Speed>(entity) == (index % 2 == 1), "Moved component differs in presence!");
+		if (index % 3 == 0)
+			Check(destination.GetComponent<Name>(entity).Value == std::string(40, static_cast<char>('a' + index % 26)), "Moved name differs!");
+		if (index % 5 == 0)
+		{
+			Position position = destination.GetComponent<Position>(entity);
+			Check(position.X == static_cast<float>(index) && position.Y == index * 2, "Moved field component differs!");
+		}
+	}
+
+	Check(destination.GetParent(migrated[1]) == migrated[0] && destination.GetParent(migrated[2]) == migrated[1], "Relation inside the moved entities was lost!");
+	Check(!destination.GetParent(migrated[3]).IsHandleValid(), "Relation to an entity that stayed was moved!");
+	Check(!source.GetParent(entities[51]).IsHandleValid(), "Child of a moved entity kept its parent!");
+	Check(group.Size() == 6, "Moved entities were not grouped!");
+	Check(removed == 10 && added == 11, "Observers were not notified!");
+
+	size_t changed = 0;
+	destination.EachChanged<Health>(sinceTick, [&](HyperECS::Entity, Health&) { changed++; });
+	Check(changed == 10, "Moved components are not marked as changed!");
+	Check(source.GetEntities<Health>().size() == 90, "Moved components stayed in the source!");
+
+	HyperECS::Entity returned = destination.Migrate(migrated[4], source);
+	Check(source.GetComponent<Health>(returned).Value == 4, "Single entity was not moved back!");
+
+	destination.Merge(source);
+	Check(source.GetEntities().empty(), "Merged registry is not empty!");
+	Check(destination.GetEntities<Health>().size() == 101 && added == 102, "Merged components are missing!");
+}
+
+/**
+ * @brief Loading a component class that only the saving registry registered
+ */
+static void SharedRegistration()
+{
+	HyperECS::Registry source;
+	source.Register<Score>();
+	HyperECS::Entity entity = source.Construct();
+	source.AddComponent<Score>(entity, 7);
+
+	std::stringstream snapshot;
+	source.Save(snapshot);
+
+	HyperECS::Registry loaded;
+	loaded.Load(snapshot);
+	Check(loaded.GetComponent<Score>(entity).Value == 7, "Component of another registry was not loaded!");
+}
+
+/**
+ * @brief Migrating entities in opposite directions from two threads
+ */
+static void ConcurrentMigrations()
+{
+#ifdef HYPERECS_MUTEX
+	HyperECS::Registry first;
+	HyperECS::Registry second;
+	std::vector<HyperECS::Entity> firstEntities;
+	std::vector<HyperECS::Entity> secondEntities;
+	first.Construct(2000, std::back_inserter(firstEntities));
+	second.Construct(2000, std::back_inserter(secondEntities));
+	first.AddComponents<Health>(firstEntities, Health{ 1 });
+	second.AddComponents<Health>(secondEntities, Health{ 2 });
+
+	std::vector<HyperECS::Entity> toFirst;
+	std::vector<HyperECS::Entity> toSecond;
+	std::thread thread([&]()
+	{
+		for (size_t index = 0; index < firstEntities.size(); index += 100)
+			first.Migrate(std::span<const HyperECS::Entity>(firstEntities.data() + index, 100), second, std::back_inserter(toSecond));
+	});
+
+	for (size_t index = 0; index < secondEntities.size(); index += 100)
+		second.Migrate(std::span<const HyperECS::Entity>(secondEntities.data() + index, 100), first, std::back_inserter(toFirst));
+	thread.join();
+
+	Check(first.GetEntities<Health>().size() + second.GetEntities<Health>().size() == 4000, "Concurrent migrations lost components!");
+#endif /* HYPERECS_MUTEX */
+}
+
+/**
+ * @brief Moving entities between registries and worlds
+ *
+ * @return Returns the exit code
+ */
+int main()
+{
+	MigrateEntities();
+	SharedRegistration();
+	ConcurrentMigrations();
+
+	HyperECS::World first;
+	HyperECS::World second;
+	HyperECS::Entity entity = first.Construct();
+	first.AddComponent<Health>(entity, 3);
+	HyperECS::Entity migrated = first.Migrate(entity, second);
+	Check(second.GetComponent<Health>(migrated).Value == 3, "World did not move the entity!");
+	first.Merge(second);
+	Check(first.GetEntities().size() == 1 && second.GetEntities().empty(), "World did not merge the entity!");
+
+	return HyperECSTests::Finish("Migrate");
+}
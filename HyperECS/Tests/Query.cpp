@@ -0,0 +1,131 @@
+#include "HyperECS.h"
+
+#include "Check.h"
+
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <vector>
+
+using HyperECSTests::Check;
+
+/* Required component */
+struct Alpha
+{
+	int Value;
+};
+
+/* Second required component */
+struct Beta
+{
+	int Value;
+};
+
+/* Component that is excluded or optional */
+struct Gamma
+{
+	int Value;
+};
+
+/* Component no entity has */
+struct Delta
+{
+	int Value;
+};
+
+/* Optional field component */
+struct Position
+{
+	float X;
+};
+
+template<>
+struct HyperECS::ComponentTraits<Position>
+{
+	static constexpr auto Fields = std::make_tuple(&Position::X);
+};
+
+/**
+ * @brief Comparing queries with required, excluded, optional and changed components against a brute force search
+ *
+ * @return Returns the exit code
+ */
+int main()
+{
+	HyperECS::Registry registry;
+	std::vector<HyperECS::Entity> entities;
+	registry.Construct(3000, std::back_inserter(entities));
+
+	std::mt19937 random(5);
+	for (HyperECS::Entity entity : entities)
+	{
+		if (random() % 2)
+			registry.AddComponent<Alpha>(entity, 1);
+		if (random() % 5 == 0)
+			registry.AddComponent<Beta>(entity, 2);
+		if (random() % 3 == 0)
+			registry.AddComponent<Gamma>(entity, 3);
+		if (random() % 4 == 0)
+			registry.AddComponent<Position>(entity, 4.0f);
+	}
+
+	uint64_t sinceTick = registry.AdvanceTick();
+	for (HyperECS::Entity entity : entities)
+	{
+		if (registry.HasComponent<Alpha>(entity) && random() % 3 == 0)
+			registry.PatchComponent<Alpha>(entity).Value = 7;
+	}
+
+	size_t expected = 0;
+	size_t expectedChanged = 0;
+	for (HyperECS::Entity entity : entities)
+	{
+		if (registry.HasComponent<Alpha>(entity) && registry.HasComponent<Beta>(entity) && !registry.HasComponent<Gamma>(entity))
+			expected++;
+		if (registry.HasComponent<Alpha>(entity) && registry.GetComponent<Alpha>(entity).Value == 7)
+			expectedChanged++;
+	}
+
+	size_t matched = 0;
+	registry.Query<Alpha, Beta, HyperECS::Without<Gamma>, HyperECS::Optional<Position>>().Each([&](HyperECS::Entity entity, Alpha& alpha, Beta& beta, std::optional<HyperECS::FieldReference<Position>> position)
+	{
+		Check((alpha.Value == 1 || alpha.Value == 7) && beta.Value == 2, "Required components differ!");
+		Check(!registry.HasComponent<Gamma>(entity), "Excluded component is present!");
+		Check(position.has_value() == registry.HasComponent<Position>(entity), "Optional field component differs in presence!");
+		if (position)
+			Check(position->Get<&Position::X>() == 4.0f, "Optional field component differs in value!");
+		matched++;
+	});
+	Check(matched == expected, "Query matched other entities!");
+
+	size_t changed = 0;
+	registry.Query<HyperECS::Changed<Alpha>, HyperECS::Without<Delta>, HyperECS::Optional<Gamma>>(sinceTick).Each([&](HyperECS::Entity entity, Alpha& alpha, Gamma* gamma)
+	{
+		Check(alpha.Value == 7, "Unchanged component was visited!");
+		Check((gamma != nullptr) == registry.HasComponent<Gamma>(entity), "Optional component differs in presence!");
+		changed++;
+	});
+	Check(changed == expectedChanged, "Changed components are missing!");
+
+	Check(registry.Query<Alpha, Beta, HyperECS::Without<Gamma>>().GetEntities().size() == expected, "Query entities differ!");
+	Check(registry.Query<Alpha, Delta>().GetEntities().empty(), "Query matched a missing component!");
+
+	registry.Query<Beta, HyperECS::Without<Gamma>>().Each([&](HyperECS::Entity entity, Beta&)
+	{
+		registry.RemoveComponent<Beta>(entity);
+	});
+	registry.Each<Beta>([&](HyperECS::Entity entity, Beta&)
+	{
+		Check(registry.HasComponent<Gamma>(entity), "Component removed during the query is still present!");
+	});
+
+	HyperECS::World world;
+	HyperECS::Entity entity = world.Construct();
+	world.AddComponent<Alpha>(entity, 1);
+	size_t worldMatched = 0;
+	world.Query<Alpha, HyperECS::Without<Beta>>().Each([&](HyperECS::Entity, Alpha&) { worldMatched++; });
+	Check(worldMatched == 1, "World query differs!");
+
+	return HyperECSTests::Finish("Query");
+}
@@ -0,0 +1,74 @@
+#include "HyperECS.h"
+
+#include "Check.h"
+
+#include <string>
+
+using HyperECSTests::Check;
+
+/* Resource written once per frame */
+struct Time
+{
+	float Delta;
+};
+
+/* Resource with a non trivial member */
+struct Config
+{
+	std::string Name;
+	int Level;
+};
+
+/* System that reads a resource through its registry */
+class TimeSystem : public HyperECS::System
+{
+public:
+	/* Accumulated time of all ticks */
+	float Elapsed = 0.0f;
+
+	void OnTick(HyperECS::Registry& registry, int /* currentTick */) override
+	{
+		Elapsed += registry.GetResource<Time>().Delta;
+	}
+
+	void OnUpdate(HyperECS::Registry& /* registry */, float /* deltaTime */) override
+	{
+	}
+
+	void OnRender(HyperECS::Registry& /* registry */) override
+	{
+	}
+};
+
+/**
+ * @brief Setting, replacing, reading and removing resources of a world and reading them from a system
+ *
+ * @return Returns the exit code
+ */
+int main()
+{
+	HyperECS::World world;
+	Check(!world.HasResource<Time>(), "Resource exists before it was set!");
+	Check(world.TryGetResource<Time>() == nullptr, "Missing resource is not null!");
+
+	world.SetResource<Time>(0.5f);
+	world.SetResource<Config>("Level", 3);
+	Check(world.GetResource<Config>().Name == "Level" && world.GetResource<Config>().Level == 3, "Resource was not constructed from the arguments!");
+
+	world.AddSystem<TimeSystem>();
+	for (int tick = 0; tick < 4; tick++)
+		world.OnTick(tick);
+	Check(world.GetSystem<TimeSystem>().Elapsed == 2.0f, "System did not read the resource!");
+
+	world.SetResource<Time>(1.0f);
+	Check(world.GetResource<Time>().Delta == 1.0f, "Resource was not replaced!");
+
+	world.GetResource<Config>().Level++;
+	Check(world.TryGetResource<Config>()->Level == 4, "Resource was returned by value!");
+
+	world.RemoveResource<Time>();
+	Check(!world.HasResource<Time>(), "Resource exists after it was removed!");
+	Check(world.HasResource<Config>(), "Other resource was removed!");
+
+	return HyperECSTests::Finish("Resources");
+}
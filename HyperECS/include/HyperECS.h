@@ -1,14 +1,39 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <new>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
-#include <queue>
 
 /* Definition for Mutex */
 #ifdef HYPERECS_MUTEX
+#include <shared_mutex>
 #endif /* HYPERECS_MUTEX */
 
 namespace HyperECS
@@ -16,8 +41,32 @@ namespace HyperECS
 	/* Wrapper for entity UUID */
 	struct Entity
 	{
-		/* Type id hash code from the entity */
-		size_t Handle;
+		/* Index of the entity in the low and generation of the index in the high 32 bits */
+		uint64_t Handle;
+
+		/**
+		 * @brief Packing an index and a generation into an entity
+		 *
+		 * @param index The index of the entity
+		 * @param generation The generation of the index
+		 *
+		 * @return Returns the entity
+		 */
+		static Entity Create(uint32_t index, uint32_t generation) { return Entity({ static_cast<uint64_t>(generation) << 32 | index }); }
+
+		/**
+		 * @brief Getting the index of the entity
+		 *
+		 * @return Returns the index of the entity
+		 */
+		uint32_t GetIndex() const { return static_cast<uint32_t>(Handle); }
+
+		/**
+		 * @brief Getting the generation of the entity
+		 *
+		 * @return Returns the generation of the entity
+		 */
+		uint32_t GetGeneration() const { return static_cast<uint32_t>(Handle >> 32); }
 
 		/**
 		 * @brief Checks if the entity is valid
@@ -34,627 +83,6971 @@ namespace HyperECS
 		bool operator==(const Entity& other) const { return Handle == other.Handle; }
 	};
 
-	class Registry
+	/* Sequential ids for the classes of a family, so lookups index arrays instead of hashing typeids */
+	template<class Family>
+	class TypeIndex
 	{
 	private:
-		/* Hasher to hash entity struct */
-		struct EntityHasher
-		{
-			/**
-			 * @brief Hashes the entity
-			 *
-			 * @param entity The entity that is getting hashed
-			 *
-			 * @return Returns the hash of the entity
-			 */
-			size_t operator()(const Entity& entity) const { return (std::hash<size_t>()(entity.Handle)); }
-		};
+		/* The id the next class of the family receives */
+		static inline std::atomic<size_t> s_NextIndex = 0;
 
-		/* Component struct to hold data from a specified component */
-		struct ComponentIndex
+	public:
+		/**
+		 * @brief Getting the id of a class, it is handed out the first time the class is requested
+		 *
+		 * @tparam T The class of the family
+		 *
+		 * @return Returns the id of the class
+		 */
+		template<class T>
+		static size_t Get()
 		{
-			/* Type id hash code from the component */
-			size_t Handle;
+			static const size_t index = s_NextIndex.fetch_add(1, std::memory_order_relaxed);
+			return index;
+		}
+	};
 
-			/* Index from the component in the component map */
-			size_t Index;
+	/**
+	 * @brief Getting a hash of the name of a class that stays the same between runs, used to identify classes in snapshots
+	 *
+	 * @tparam T The class
+	 *
+	 * @return Returns the hash
+	 */
+	template<class T>
+	constexpr uint64_t GetTypeHash()
+	{
+	#ifdef _MSC_VER
+		std::string_view name = __FUNCSIG__;
+	#else
+		std::string_view name = __PRETTY_FUNCTION__;
+	#endif /* _MSC_VER */
 
-			ComponentIndex(size_t handle, size_t index)
-				: Handle(handle), Index(index) {}
+		uint64_t hash = 14695981039346656037ull;
+		for (char character : name)
+		{
+			hash ^= static_cast<unsigned char>(character);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
 
-			/**
-			 * @brief Checks if the component is valid
-			 *
-			 * @return Returns if the component was valid
-			 */
-			bool IsComponentValid() const { return Handle != 0 && Index != 0; }
+	/**
+	 * @brief Getting the name of a class from the compiler without RTTI
+	 *
+	 * @tparam T The class
+	 *
+	 * @return Returns the name
+	 */
+	template<class T>
+	constexpr std::string_view GetTypeName()
+	{
+	#ifdef _MSC_VER
+		std::string_view name = __FUNCSIG__;
+		size_t begin = name.find("GetTypeName<") + 12;
+		size_t end = name.rfind(">(void)");
+	#else
+		std::string_view name = __PRETTY_FUNCTION__;
+		size_t begin = name.find("T = ") + 4;
+		size_t end = name.find_first_of(";]", begin);
+	#endif /* _MSC_VER */
 
-			/**
-			 * @brief Compares component to an another
-			 *
-			 * @return Returns if the component is the same
-			 */
-			bool operator==(const ComponentIndex& other) const { return Handle == other.Handle && Index == other.Index; }
-		};
+		return name.substr(begin, end - begin);
+	}
+
+	/**
+	 * @brief Writing trivially copyable values to a stream as raw bytes
+	 *
+	 * @tparam T The class of the values
+	 * @param stream The stream that is written to
+	 * @param data The values
+	 * @param count The amount of values
+	 */
+	template<class T>
+	void WriteBinary(std::ostream& stream, const T* data, size_t count = 1)
+	{
+		stream.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(sizeof(T) * count));
+	}
 
-		/* Holds the free entries in the component map */
-		std::queue<size_t> m_FreeIndex;
+	/**
+	 * @brief Reading trivially copyable values from a stream as raw bytes
+	 *
+	 * @tparam T The class of the values
+	 * @param stream The stream that is read from
+	 * @param data The values
+	 * @param count The amount of values
+	 */
+	template<class T>
+	void ReadBinary(std::istream& stream, T* data, size_t count = 1)
+	{
+		stream.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(sizeof(T) * count));
+	}
 
-		/* Holds the typeid of a component struct and holds a vector of the object type class data */
-		std::unordered_map<size_t, std::vector<void*>> m_Components;
+	/**
+	 * @brief Writing a string to a stream as a quoted JSON string, escaping quotes, backslashes and control characters
+	 *
+	 * @param stream The stream that is written to
+	 * @param string The string that is written
+	 */
+	inline void WriteJsonString(std::ostream& stream, std::string_view string)
+	{
+		static constexpr const char* HexDigits = "0123456789abcdef";
 
-		/* Holds the entities and the corresponding components */
-		std::unordered_map<Entity, std::vector<ComponentIndex>, EntityHasher> m_Entities;
+		stream << '"';
+		for (char character : string)
+		{
+			unsigned char code = static_cast<unsigned char>(character);
+			if (character == '"' || character == '\\')
+				stream << '\\' << character;
+			else if (code < 0x20)
+				stream << "\\u00" << HexDigits[code >> 4] << HexDigits[code & 0xF];
+			else
+				stream << character;
+		}
+		stream << '"';
+	}
 
-	#ifdef HYPERECS_MUTEX
-		/* Mutex & Lock for the free entries */
-		std::mutex m_FreeLock;
+	/* Allocator of generational entity handles that recycles destroyed indices */
+	class EntityPool
+	{
+	private:
+		/* Index that terminates the free list */
+		static constexpr uint32_t NullIndex = std::numeric_limits<uint32_t>::max();
 
-		/* Mutex & Lock for the components */
-		std::mutex m_ComponentLock;
+		/* Holds the alive entity of every index, or the next free index and the next generation for destroyed ones */
+		std::vector<Entity> m_Entities;
 
-		/* Mutex & Lock for the entities */
-		std::mutex m_EntityLock;
-	#endif /* HYPERECS_MUTEX */
+		/* Index of the first destroyed entity that can be recycled */
+		uint32_t m_FreeIndex = NullIndex;
 
 	public:
 		/**
-		 * @brief Constructing an entity in the registry
+		 * @brief Creating an entity, recycling the index of a destroyed entity with the next generation if there is one
 		 *
-		 * @return Returns an entity
+		 * @return Returns the entity
 		 */
-		Entity Construct()
+		Entity Create()
 		{
-		#ifdef HYPERECS_MUTEX
-			std::unique_lock<std::mutex> entityLock(m_EntityLock);
-		#endif /* HYPERECS_MUTEX */
+			if (m_FreeIndex == NullIndex)
+				return m_Entities.emplace_back(Entity::Create(static_cast<uint32_t>(m_Entities.size()), 1));
 
-			Entity entity = Entity({ m_Entities.size() });
-			m_Entities[entity] = {};
-			return entity;
+			uint32_t index = m_FreeIndex;
+			m_FreeIndex = m_Entities[index].GetIndex();
+			return m_Entities[index] = Entity::Create(index, m_Entities[index].GetGeneration());
 		}
 
 		/**
-		 * @brief Destroying an entity in the registry
+		 * @brief Reserving memory for entities that are going to be created
 		 *
-		 * @param entity Entity that is getting destroyed
+		 * @param count The amount of entities that are going to be created
 		 */
-		void Destroy(Entity entity)
+		void Reserve(size_t count)
 		{
-		#ifdef HYPERECS_MUTEX
-			std::unique_lock<std::mutex> entityLock(m_EntityLock);
-		#endif /* HYPERECS_MUTEX */
-			if (m_Entities.find(entity) != m_Entities.end())
-			{
-				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
-				__debugbreak();
-			}
+			m_Entities.reserve(m_Entities.size() + count);
+		}
 
-			m_Entities.erase(entity);
+		/**
+		 * @brief Releasing an entity and pushing its index onto the free list
+		 *
+		 * @param entity The entity that is getting released
+		 */
+		void Release(Entity entity)
+		{
+			uint32_t generation = entity.GetGeneration() + 1;
+			m_Entities[entity.GetIndex()] = Entity::Create(m_FreeIndex, generation != 0 ? generation : 1);
+			m_FreeIndex = entity.GetIndex();
 		}
 
 		/**
-		 * @brief Adding component to an entity
+		 * @brief Check if an entity is alive
 		 *
-		 * @tparam T The component class that is getting created
-		 * @tparam Args The arguments for the class
-		 * @param entity The corresponding entity that the component getting assigned to
-		 * @param args The arguments for the class
+		 * @param entity The entity that is getting checked
 		 *
-		 * @return Returns the created component
+		 * @return Returns if the entity was alive
 		 */
-		template<class T, typename... Args>
-		constexpr T& AddComponent(Entity entity, Args&&... args)
+		bool IsValid(Entity entity) const
 		{
-		#ifdef HYPERECS_MUTEX
-			std::unique_lock<std::mutex> entityLock(m_EntityLock);
-		#endif /* HYPERECS_MUTEX */
-
-			if (m_Entities.find(entity) == m_Entities.end())
-			{
-				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
-				__debugbreak();
-			}
-
-		#ifdef HYPERECS_MUTEX
-			entityLock.unlock();
-		#endif /* HYPERECS_MUTEX */
-
-			if (HasComponent<T>(entity))
-			{
-				std::cerr << "[HyperECS] Entity already has the component!" << std::endl;
-				__debugbreak();
-			}
-
-		#ifdef HYPERECS_MUTEX
-			entityLock.lock();
-		#endif /* HYPERECS_MUTEX */
-
-			size_t componentId = typeid(T).hash_code();
-			if (m_Components.find(componentId) == m_Components.end())
-				m_Components[componentId] = {};
-
-		#ifdef HYPERECS_MUTEX
-			std::unique_lock<std::mutex> freeLock(m_FreeLock);
-			std::unique_lock<std::mutex> componentLock(m_ComponentLock);
-		#endif /* HYPERECS_MUTEX */
-
-			size_t index = 0;
-			T* component;
-			if (m_FreeIndex.empty())
-			{
-				index = m_Components[componentId].size();
-				component = static_cast<T*>(m_Components[componentId].emplace_back((void*) new T(std::forward<Args>(args)...)));
-			}
-			else
-			{
-				index = m_FreeIndex.front();
-				m_FreeIndex.pop();
-				component = static_cast<T*>(m_Components[componentId][index] = ((void*) new T(std::forward<Args>(args)...)));
-			}
-
-			m_Entities[entity].emplace_back(componentId, index);
-
-			return *component;
+			return entity.GetIndex() < m_Entities.size() && m_Entities[entity.GetIndex()] == entity;
 		}
 
 		/**
-		 * @brief Removing component from an entity
+		 * @brief Calling a function for every alive entity
 		 *
-		 * @tparam T The component class that is getting removed
-		 * @param entity The corresponding entity where component getting removed
+		 * @tparam Function The type of the function
+		 * @param function Function that is getting called for every entity
 		 */
-		template<class T>
-		constexpr void RemoveComponent(Entity entity)
+		template<class Function>
+		void Each(Function&& function) const
 		{
-		#ifdef HYPERECS_MUTEX
-			std::unique_lock<std::mutex> entityLock(m_EntityLock);
-		#endif /* HYPERECS_MUTEX */
-
-			if (m_Entities.find(entity) == m_Entities.end())
-			{
-				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
-				__debugbreak();
-			}
-
-		#ifdef HYPERECS_MUTEX
-			entityLock.unlock();
-		#endif /* HYPERECS_MUTEX */
-
-			if (!HasComponent<T>(entity))
-			{
-				std::cerr << "[HyperECS] Entity has not the component!" << std::endl;
-				__debugbreak();
-			}
-
-		#ifdef HYPERECS_MUTEX
-			entityLock.lock();
-
-			std::unique_lock<std::mutex> freeLock(m_FreeLock);
-			std::unique_lock<std::mutex> componentLock(m_ComponentLock);
-		#endif /* HYPERECS_MUTEX */
+			for (uint32_t index = 0; index < m_Entities.size(); index++)
+				if (m_Entities[index].GetIndex() == index)
+					function(m_Entities[index]);
+		}
 
-			size_t componentId = typeid(T).hash_code();
-			std::vector<ComponentIndex>& components = m_Entities[entity];
-			for (ComponentIndex& component : components)
-				if (component.Handle == componentId)
-				{
-					m_Components[componentId][component.Index] = nullptr;
-					m_FreeIndex.push(component.Index);
-					components.erase(std::find(components.begin(), components.end(), component));
-				}
+		/**
+		 * @brief Getting the alive entity of an index
+		 *
+		 * @param index The index of the entity
+		 *
+		 * @return Returns the entity or the null entity if the index belongs to a destroyed entity
+		 */
+		Entity GetEntity(uint32_t index) const
+		{
+			return m_Entities[index].GetIndex() == index ? m_Entities[index] : Entity({ 0 });
 		}
 
 		/**
-		 * @brief Removing multiple components from an entity
+		 * @brief Getting all alive entities
 		 *
-		 * @tparam T The component classes that are getting removed
-		 * @param entity The corresponding entity where component getting removed
+		 * @return Returns all alive entities
 		 */
-		template<class... T>
-		constexpr void RemoveMultipleComponent(Entity entity)
+		std::vector<Entity> GetEntities() const
 		{
-		#ifdef HYPERECS_MUTEX
-			std::unique_lock<std::mutex> entityLock(m_EntityLock);
-		#endif /* HYPERECS_MUTEX */
+			std::vector<Entity> entities;
+			Each([&](Entity entity) { entities.push_back(entity); });
+			return entities;
+		}
 
-			if (m_Entities.find(entity) == m_Entities.end())
-			{
-				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
-				__debugbreak();
-			}
+		/**
+		 * @brief Getting the amount of indices that were handed out so far
+		 *
+		 * @return Returns the amount of indices
+		 */
+		size_t Size() const
+		{
+			return m_Entities.size();
+		}
 
-		#ifdef HYPERECS_MUTEX
-			entityLock.unlock();
-		#endif /* HYPERECS_MUTEX */
+		/**
+		 * @brief Getting the amount of indices the pool can hold without reallocating
+		 *
+		 * @return Returns the amount of indices
+		 */
+		size_t Capacity() const
+		{
+			return m_Entities.capacity();
+		}
 
-			if (!HasMultipleComponent<T...>(entity))
-			{
-				std::cerr << "[HyperECS] Entity has not the component!" << std::endl;
-				__debugbreak();
-			}
+		/**
+		 * @brief Getting the amount of destroyed entities whose indices wait on the free list to be recycled
+		 *
+		 * @return Returns the amount of indices
+		 */
+		size_t GetFreeCount() const
+		{
+			size_t count = 0;
+			for (uint32_t index = m_FreeIndex; index != NullIndex; index = m_Entities[index].GetIndex())
+				count++;
+			return count;
+		}
 
-		#ifdef HYPERECS_MUTEX
-			entityLock.lock();
-		#endif /* HYPERECS_MUTEX */
+		/**
+		 * @brief Writing the entities and the free list to a stream
+		 *
+		 * @param stream The stream that is written to
+		 */
+		void Save(std::ostream& stream) const
+		{
+			uint64_t size = m_Entities.size();
+			WriteBinary(stream, &size);
+			WriteBinary(stream, m_Entities.data(), m_Entities.size());
+			WriteBinary(stream, &m_FreeIndex);
+		}
 
-			auto lambda = [&]<typename C>() mutable
-			{
-			#ifdef HYPERECS_MUTEX
-				entityLock.unlock();
-			#endif /* HYPERECS_MUTEX */
+		/**
+		 * @brief Replacing the entities and the free list with the ones of a stream
+		 *
+		 * @param stream The stream that is read from
+		 */
+		void Load(std::istream& stream)
+		{
+			uint64_t size = 0;
+			ReadBinary(stream, &size);
+			m_Entities.resize(size);
+			ReadBinary(stream, m_Entities.data(), m_Entities.size());
+			ReadBinary(stream, &m_FreeIndex);
+		}
 
-				RemoveComponent<C>(entity);
+		/**
+		 * @brief Writing the amount of indices, the free list and the entities of some indices to a stream
+		 *
+		 * @param stream The stream that is written to
+		 * @param indices The indices whose entities are written
+		 */
+		void SaveDelta(std::ostream& stream, const std::vector<uint32_t>& indices) const
+		{
+			uint64_t size = m_Entities.size();
+			uint64_t count = indices.size();
+			WriteBinary(stream, &size);
+			WriteBinary(stream, &m_FreeIndex);
+			WriteBinary(stream, &count);
+			WriteBinary(stream, indices.data(), indices.size());
 
-			#ifdef HYPERECS_MUTEX
-				entityLock.lock();
-			#endif /* HYPERECS_MUTEX */
-			};
-			(lambda.template operator() < T > (), ...);
+			std::vector<Entity> entities;
+			entities.reserve(indices.size());
+			for (uint32_t index : indices)
+				entities.push_back(m_Entities[index]);
+			WriteBinary(stream, entities.data(), entities.size());
 		}
 
 		/**
-		 * @brief Getting component from an entity
+		 * @brief Applying the amount of indices, the free list and the entities of a stream written by SaveDelta
 		 *
-		 * @tparam T The component class that is searched for
-		 * @param entity The corresponding entity that the component is assigned to
+		 * @param stream The stream that is read from
+		 * @param released The alive entities that were destroyed, replaced or cut off by the delta
 		 *
-		 * @return Returns the corresponding component
+		 * @return Returns the indices whose entities were written
 		 */
-		template<class T>
-		constexpr T& GetComponent(Entity entity)
+		std::vector<uint32_t> LoadDelta(std::istream& stream, std::vector<Entity>& released)
 		{
-		#ifdef HYPERECS_MUTEX
-			std::unique_lock<std::mutex> entityLock(m_EntityLock);
-		#endif /* HYPERECS_MUTEX */
+			uint64_t size = 0;
+			uint64_t count = 0;
+			ReadBinary(stream, &size);
+			ReadBinary(stream, &m_FreeIndex);
+			ReadBinary(stream, &count);
+
+			std::vector<uint32_t> indices(count);
+			std::vector<Entity> entities(count);
+			ReadBinary(stream, indices.data(), indices.size());
+			ReadBinary(stream, entities.data(), entities.size());
 
-			if (m_Entities.find(entity) == m_Entities.end())
+			for (size_t index = size; index < m_Entities.size(); index++)
 			{
-				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
-				__debugbreak();
+				Entity previous = GetEntity(static_cast<uint32_t>(index));
+				if (previous.IsHandleValid())
+					released.push_back(previous);
 			}
 
-		#ifdef HYPERECS_MUTEX
-			entityLock.unlock();
-		#endif /* HYPERECS_MUTEX */
-
-			if (!HasComponent<T>(entity))
+			m_Entities.resize(size);
+			for (size_t index = 0; index < indices.size(); index++)
 			{
-				std::cerr << "[HyperECS] Entity has not the component!" << std::endl;
-				__debugbreak();
+				Entity previous = GetEntity(indices[index]);
+				if (previous.IsHandleValid() && !(previous == entities[index]))
+					released.push_back(previous);
+				m_Entities[indices[index]] = entities[index];
 			}
+			return indices;
+		}
+	};
 
-		#ifdef HYPERECS_MUTEX
-			entityLock.lock();
+	/* Sparse set that maps entities to packed slots */
+	class SparseSet
+	{
+	public:
+		/* Slot of an entity that is not part of the set */
+		static constexpr size_t Null = std::numeric_limits<size_t>::max();
 
-			std::unique_lock<std::mutex> freeLock(m_FreeLock);
-			std::unique_lock<std::mutex> componentLock(m_ComponentLock);
-		#endif /* HYPERECS_MUTEX */
+	private:
+		/* Amount of entity indices that share one sparse page */
+		static constexpr size_t PageSize = 4096;
 
-			size_t componentId = typeid(T).hash_code();
-			std::vector<ComponentIndex> components = m_Entities[entity];
-			for (ComponentIndex component : components)
-				if (component.Handle == componentId)
-					return *static_cast<T*>(m_Components[componentId][component.Index]);
-		}
+		/* Holds the entities back to back in memory */
+		std::vector<Entity> m_Dense;
+
+		/* Holds the pages that map an entity index to its slot in m_Dense */
+		std::vector<std::unique_ptr<size_t[]>> m_Sparse;
 
+	public:
 		/**
-		 * @brief Check if an entity has a component
+		 * @brief Inserting an entity at the end of the set
 		 *
-		 * @tparam T The component class that is getting checked
-		 * @param entity The corresponding entity that the component is assigned to
+		 * @param entity The entity that is getting inserted
 		 *
-		 * @return Returns if the component was found
+		 * @return Returns the slot of the entity
 		 */
-		template<class T>
-		constexpr bool HasComponent(Entity entity)
+		size_t Insert(Entity entity)
 		{
-		#ifdef HYPERECS_MUTEX
-			std::unique_lock<std::mutex> entityLock(m_EntityLock);
-		#endif /* HYPERECS_MUTEX */
-
-			if (m_Entities.find(entity) == m_Entities.end())
+			size_t index = entity.GetIndex();
+			size_t page = index / PageSize;
+			if (page >= m_Sparse.size())
+				m_Sparse.resize(page + 1);
+			if (!m_Sparse[page])
 			{
-				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
-				__debugbreak();
+				m_Sparse[page] = std::make_unique<size_t[]>(PageSize);
+				std::fill_n(m_Sparse[page].get(), PageSize, Null);
 			}
 
-		#ifdef HYPERECS_MUTEX
-			std::unique_lock<std::mutex> componentLock(m_ComponentLock);
-		#endif /* HYPERECS_MUTEX */
-
-			size_t componentId = typeid(T).hash_code();
-			std::vector<ComponentIndex> components = m_Entities[entity];
-			for (ComponentIndex component : components)
-				if (component.Handle == componentId)
-					return true;
-			return false;
+			m_Sparse[page][index % PageSize] = m_Dense.size();
+			m_Dense.push_back(entity);
+			return m_Dense.size() - 1;
 		}
 
 		/**
-		 * @brief Check if an entity has multiple components
+		 * @brief Erasing an entity by moving the last entity into its slot
 		 *
-		 * @tparam T The component classes that are getting checked
-		 * @param entity The corresponding entity that the component is assigned to
+		 * @param entity The entity that is getting erased
 		 *
-		 * @return Returns if the components were found
+		 * @return Returns the slot the entity was stored in
+		 */
+		size_t Erase(Entity entity)
+		{
+			size_t slot = GetSlot(entity);
+			Entity last = m_Dense.back();
+			m_Dense[slot] = last;
+			m_Sparse[last.GetIndex() / PageSize][last.GetIndex() % PageSize] = slot;
+			m_Sparse[entity.GetIndex() / PageSize][entity.GetIndex() % PageSize] = Null;
+			m_Dense.pop_back();
+			return slot;
+		}
+
+		/**
+		 * @brief Check if the set holds an entity
+		 *
+		 * @param entity The entity that is getting checked
+		 *
+		 * @return Returns if the entity was found
+		 */
+		bool Contains(Entity entity) const
+		{
+			return GetSlot(entity) != Null;
+		}
+
+		/**
+		 * @brief Getting the slot of an entity
+		 *
+		 * @param entity The entity that is searched for
+		 *
+		 * @return Returns the slot or Null if the entity is not part of the set
+		 */
+		size_t GetSlot(Entity entity) const
+		{
+			size_t page = entity.GetIndex() / PageSize;
+			if (page >= m_Sparse.size() || !m_Sparse[page])
+				return Null;
+
+			size_t slot = m_Sparse[page][entity.GetIndex() % PageSize];
+			if (slot == Null || !(m_Dense[slot] == entity))
+				return Null;
+			return slot;
+		}
+
+		/**
+		 * @brief Exchanging the entities of two slots
+		 *
+		 * @param left The first slot
+		 * @param right The second slot
+		 */
+		void Swap(size_t left, size_t right)
+		{
+			std::swap(m_Dense[left], m_Dense[right]);
+			m_Sparse[m_Dense[left].GetIndex() / PageSize][m_Dense[left].GetIndex() % PageSize] = left;
+			m_Sparse[m_Dense[right].GetIndex() / PageSize][m_Dense[right].GetIndex() % PageSize] = right;
+		}
+
+		/**
+		 * @brief Reserving memory for entities in the set
+		 *
+		 * @param capacity The amount of entities the set can hold without reallocating
+		 */
+		void Reserve(size_t capacity)
+		{
+			m_Dense.reserve(capacity);
+		}
+
+		/**
+		 * @brief Getting the memory of the pages that map entities to slots
+		 *
+		 * @return Returns the size in bytes
+		 */
+		size_t GetSparseMemory() const
+		{
+			size_t pageCount = std::count_if(m_Sparse.begin(), m_Sparse.end(), [](const std::unique_ptr<size_t[]>& page) { return page != nullptr; });
+			return m_Sparse.capacity() * sizeof(std::unique_ptr<size_t[]>) + pageCount * PageSize * sizeof(size_t);
+		}
+
+		/**
+		 * @brief Getting the memory of the entities and the pages of the set
+		 *
+		 * @return Returns the size in bytes
+		 */
+		size_t GetMemory() const
+		{
+			return m_Dense.capacity() * sizeof(Entity) + GetSparseMemory();
+		}
+
+		/**
+		 * @brief Removing every entity from the set
+		 */
+		void Clear()
+		{
+			m_Dense.clear();
+			m_Sparse.clear();
+		}
+
+		/**
+		 * @brief Getting the amount of entities in the set
+		 *
+		 * @return Returns the amount of entities
+		 */
+		size_t Size() const
+		{
+			return m_Dense.size();
+		}
+
+		/**
+		 * @brief Getting the packed entities
+		 *
+		 * @return Returns the entities of the set
+		 */
+		const std::vector<Entity>& GetEntities() const
+		{
+			return m_Dense;
+		}
+	};
+
+	/**
+	 * @brief Customization point for the storage of a component class, a specialization only declares the members it changes
+	 *
+	 * - Allocator: Allocator of the memory the components are stored in, every pool default constructs its own
+	 * - static void Serialize(std::ostream&, const T&) and static T Deserialize(std::istream&): Writing and reading
+	 *   the component in snapshots, needed for classes that are not trivially copyable
+	 * - static constexpr std::tuple Fields: Member pointers to the fields of a plain numeric component, every field is
+	 *   stored in its own aligned array and the registry hands out FieldReference instead of T&
+	 *
+	 * @tparam T The component class
+	 */
+	template<class T>
+	struct ComponentTraits
+	{
+	};
+
+	/* Allocator of a component class, std::allocator unless the component traits declare one */
+	template<class T>
+	struct ComponentAllocator
+	{
+		using Type = std::allocator<T>;
+	};
+
+	template<class T> requires requires { typename ComponentTraits<T>::Allocator; }
+	struct ComponentAllocator<T>
+	{
+		using Type = typename ComponentTraits<T>::Allocator;
+	};
+
+	/* Allocator that aligns its memory, so vectorized loops can use aligned loads and stores */
+	template<class T, size_t Alignment>
+	struct AlignedAllocator
+	{
+		using value_type = T;
+
+		template<class U>
+		struct rebind
+		{
+			using other = AlignedAllocator<U, Alignment>;
+		};
+
+		AlignedAllocator() = default;
+
+		template<class U>
+		AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+		T* allocate(size_t count)
+		{
+			return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+		}
+
+		void deallocate(T* data, size_t count)
+		{
+			::operator delete(data, count * sizeof(T), std::align_val_t(Alignment));
+		}
+
+		template<class U>
+		bool operator==(const AlignedAllocator<U, Alignment>&) const
+		{
+			return true;
+		}
+	};
+
+	/* Alignment of the field arrays of field components, enough for AVX-512 */
+	inline constexpr size_t FieldAlignment = 64;
+
+	/* Class and type of a member pointer */
+	template<class Member>
+	struct MemberTraits;
+
+	template<class C, class F>
+	struct MemberTraits<F C::*>
+	{
+		using Class = C;
+		using Type = F;
+	};
+
+	/* Component class whose component traits declare its fields, it is stored as struct of arrays */
+	template<class T>
+	concept FieldComponent = requires { ComponentTraits<T>::Fields; } && std::is_default_constructible_v<T>;
+
+	template<class T>
+	class FieldReference;
+
+	/* What the registry hands out for a component, a reference or for field components a reference to the slot */
+	template<class T>
+	using ComponentReference = std::conditional_t<FieldComponent<T>, FieldReference<T>, T&>;
+
+	/* Component class that the component traits can write and read */
+	template<class T>
+	concept CustomSerializable = requires(std::ostream& output, std::istream& input, const T& component)
+	{
+		ComponentTraits<T>::Serialize(output, component);
+		{ ComponentTraits<T>::Deserialize(input) } -> std::convertible_to<T>;
+	};
+
+	/* Component class that can be part of snapshots, either by its component traits or by copying its bytes */
+	template<class T>
+	concept Serializable = CustomSerializable<T> || (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>);
+
+	class Group;
+	class Registry;
+
+	/* Change of a component that observers can be notified about */
+	enum class ComponentEvent
+	{
+		Added,
+		Changed,
+		Removed
+	};
+
+	/* Memory held by a component pool, heap memory owned by the components themselves is not counted */
+	struct ComponentMemory
+	{
+		/* The name of the component class */
+		std::string_view Name;
+
+		/* Amount of live components */
+		size_t Count = 0;
+
+		/* Amount of components the pool can hold without reallocating */
+		size_t Capacity = 0;
+
+		/* Bytes of the live components, their entities and ticks and the tracked removals */
+		size_t UsedBytes = 0;
+
+		/* Bytes reserved for components, entities, ticks and tracked removals beyond the live ones */
+		size_t UnusedBytes = 0;
+
+		/* Bytes of the pages that map entities to slots */
+		size_t SparseBytes = 0;
+	};
+
+	/* Type erased interface of a component pool */
+	class ComponentPoolBase : public SparseSet
+	{
+	private:
+		/* Holds the groups whose signature contains the component */
+		std::vector<Group*> m_Groups;
+
+		/* Holds for every slot the tick the component was added in */
+		std::vector<uint64_t> m_AddedTicks;
+
+		/* Holds for every slot the tick the component was last added or marked as changed in */
+		std::vector<uint64_t> m_ChangedTicks;
+
+		/* Holds the tick and the entity of every removed component in removal order, only if removals are tracked */
+		std::vector<std::pair<uint64_t, Entity>> m_Removed;
+
+		/* If removed components are recorded */
+		bool m_IsRemovedTracked = false;
+
+		/* Holds the observers of every component event */
+		std::vector<std::function<void(Registry&, Entity)>> m_Observers[3];
+
+	#ifdef HYPERECS_MUTEX
+		/* Mutex & Lock for the components of the pool, shared by readers */
+		std::shared_mutex m_Lock;
+	#endif /* HYPERECS_MUTEX */
+
+	public:
+		virtual ~ComponentPoolBase() = default;
+
+	#ifdef HYPERECS_MUTEX
+		/**
+		 * @brief Getting the lock of the pool
+		 *
+		 * @return Returns the lock
+		 */
+		std::shared_mutex& GetLock()
+		{
+			return m_Lock;
+		}
+	#endif /* HYPERECS_MUTEX */
+
+		/**
+		 * @brief Registering a group that has to be notified when a component is added or removed
+		 *
+		 * @param group The group that is getting registered
+		 */
+		void AddGroup(Group* group)
+		{
+			m_Groups.push_back(group);
+		}
+
+		/**
+		 * @brief Getting the groups whose signature contains the component
+		 *
+		 * @return Returns the groups
+		 */
+		const std::vector<Group*>& GetGroups() const
+		{
+			return m_Groups;
+		}
+
+		/**
+		 * @brief Getting the tick the component in a slot was added in
+		 *
+		 * @param slot The slot of the component
+		 *
+		 * @return Returns the tick
+		 */
+		uint64_t GetAddedTick(size_t slot) const
+		{
+			return m_AddedTicks[slot];
+		}
+
+		/**
+		 * @brief Getting the tick the component in a slot was last added or marked as changed in
+		 *
+		 * @param slot The slot of the component
+		 *
+		 * @return Returns the tick
+		 */
+		uint64_t GetChangedTick(size_t slot) const
+		{
+			return m_ChangedTicks[slot];
+		}
+
+		/**
+		 * @brief Marking the component in a slot as changed
+		 *
+		 * @param slot The slot of the component
+		 * @param tick The tick the component changed in
+		 */
+		void SetChangedTick(size_t slot, uint64_t tick)
+		{
+			m_ChangedTicks[slot] = tick;
+		}
+
+		/**
+		 * @brief Recording the removed components from now on
+		 */
+		void TrackRemoved()
+		{
+			m_IsRemovedTracked = true;
+		}
+
+		/**
+		 * @brief Check if removed components are recorded
+		 *
+		 * @return Returns if removals are tracked
+		 */
+		bool IsRemovedTracked() const
+		{
+			return m_IsRemovedTracked;
+		}
+
+		/**
+		 * @brief Recording that the component of an entity was removed, if removals are tracked
+		 *
+		 * @param entity The entity whose component was removed
+		 * @param tick The tick the component was removed in, not below the tick of the previous removal
+		 */
+		void RecordRemoved(Entity entity, uint64_t tick)
+		{
+			if (m_IsRemovedTracked)
+				m_Removed.emplace_back(tick, entity);
+		}
+
+		/**
+		 * @brief Getting the recorded removals
+		 *
+		 * @return Returns the tick and the entity of every removed component in removal order
+		 */
+		const std::vector<std::pair<uint64_t, Entity>>& GetRemoved() const
+		{
+			return m_Removed;
+		}
+
+		/**
+		 * @brief Forgetting the removals before a tick
+		 *
+		 * @param beforeTick The first tick whose removals are kept
+		 */
+		void TrimRemoved(uint64_t beforeTick)
+		{
+			auto end = std::partition_point(m_Removed.begin(), m_Removed.end(), [beforeTick](const std::pair<uint64_t, Entity>& removed) { return removed.first < beforeTick; });
+			m_Removed.erase(m_Removed.begin(), end);
+		}
+
+		/**
+		 * @brief Registering an observer of a component event
+		 *
+		 * @param event The event that is observed
+		 * @param observer Function that is getting called with the registry and the entity after the event
+		 */
+		void AddObserver(ComponentEvent event, std::function<void(Registry&, Entity)> observer)
+		{
+			m_Observers[static_cast<size_t>(event)].push_back(std::move(observer));
+		}
+
+		/**
+		 * @brief Getting the observers of a component event
+		 *
+		 * @param event The event that is observed
+		 *
+		 * @return Returns the observers
+		 */
+		const std::vector<std::function<void(Registry&, Entity)>>& GetObservers(ComponentEvent event) const
+		{
+			return m_Observers[static_cast<size_t>(event)];
+		}
+
+		/**
+		 * @brief Removing the component of an entity from the pool
+		 *
+		 * @param entity The entity whose component is getting removed
+		 */
+		virtual void Remove(Entity entity) = 0;
+
+		/**
+		 * @brief Removing every component from the pool
+		 */
+		virtual void Clear() = 0;
+
+		/**
+		 * @brief Getting the hash that identifies the component class in snapshots
+		 *
+		 * @return Returns the hash
+		 */
+		virtual uint64_t GetTypeHash() const = 0;
+
+		/**
+		 * @brief Check if the components can be part of snapshots
+		 *
+		 * @return Returns if the components can be written and read
+		 */
+		virtual bool IsSerializable() const = 0;
+
+		/**
+		 * @brief Writing the entities, ticks and components of the pool to a stream
+		 *
+		 * @param stream The stream that is written to
+		 */
+		virtual void Save(std::ostream& stream) const = 0;
+
+		/**
+		 * @brief Replacing the entities, ticks and components of the pool with the ones of a stream
+		 *
+		 * @param stream The stream that is read from
+		 */
+		virtual void Load(std::istream& stream) = 0;
+
+		/**
+		 * @brief Creating an empty pool of the same component class, so a registry can create pools it only knows type erased
+		 *
+		 * @return Returns the pool
+		 */
+		virtual std::unique_ptr<ComponentPoolBase> CreateEmpty() const = 0;
+
+		/**
+		 * @brief Moving components to the end of a pool of the same component class, the moved from components stay in this pool
+		 *
+		 * @param entities Pairs of an entity of this pool and the entity its component is moved to
+		 * @param destination The pool the components are moved to
+		 * @param tick The tick the components are added in at the destination
+		 */
+		virtual void MoveTo(const std::vector<std::pair<Entity, Entity>>& entities, ComponentPoolBase& destination, uint64_t tick) = 0;
+
+		/**
+		 * @brief Getting the memory the pool holds
+		 *
+		 * @return Returns the memory
+		 */
+		virtual ComponentMemory GetMemoryUsage() const = 0;
+
+		/**
+		 * @brief Writing the entities, ticks and components that were added or changed in or after a tick to a stream
+		 *
+		 * @param stream The stream that is written to
+		 * @param sinceTick The first tick whose changes are written
+		 */
+		virtual void SaveChanged(std::ostream& stream, uint64_t sinceTick) const = 0;
+
+		/**
+		 * @brief Adding or overwriting the components of a stream written by SaveChanged
+		 *
+		 * @param stream The stream that is read from
+		 * @param added The entities whose component was added
+		 */
+		virtual void LoadChanged(std::istream& stream, std::vector<Entity>& added) = 0;
+
+	protected:
+		/* Entities and ticks of the changed components of a delta */
+		struct ChangedComponents
+		{
+			/* Holds the entities of the components */
+			std::vector<Entity> Entities;
+
+			/* Holds the ticks the components were added in */
+			std::vector<uint64_t> AddedTicks;
+
+			/* Holds the ticks the components were last added or marked as changed in */
+			std::vector<uint64_t> ChangedTicks;
+		};
+
+		/**
+		 * @brief Writing the entities and ticks of the components added or changed in or after a tick to a stream
+		 *
+		 * @param stream The stream that is written to
+		 * @param sinceTick The first tick whose changes are written
+		 *
+		 * @return Returns the slots of the written components
+		 */
+		std::vector<size_t> SaveChangedEntities(std::ostream& stream, uint64_t sinceTick) const
+		{
+			std::vector<size_t> slots;
+			ChangedComponents changed;
+			for (size_t slot = 0; slot < Size(); slot++)
+				if (m_ChangedTicks[slot] >= sinceTick)
+				{
+					slots.push_back(slot);
+					changed.Entities.push_back(GetEntities()[slot]);
+					changed.AddedTicks.push_back(m_AddedTicks[slot]);
+					changed.ChangedTicks.push_back(m_ChangedTicks[slot]);
+				}
+
+			uint64_t count = slots.size();
+			WriteBinary(stream, &count);
+			WriteBinary(stream, changed.Entities.data(), changed.Entities.size());
+			WriteBinary(stream, changed.AddedTicks.data(), changed.AddedTicks.size());
+			WriteBinary(stream, changed.ChangedTicks.data(), changed.ChangedTicks.size());
+			return slots;
+		}
+
+		/**
+		 * @brief Reading the entities and ticks written by SaveChangedEntities
+		 *
+		 * @param stream The stream that is read from
+		 *
+		 * @return Returns the entities and ticks
+		 */
+		ChangedComponents LoadChangedEntities(std::istream& stream)
+		{
+			uint64_t count = 0;
+			ReadBinary(stream, &count);
+
+			ChangedComponents changed;
+			changed.Entities.resize(count);
+			changed.AddedTicks.resize(count);
+			changed.ChangedTicks.resize(count);
+			ReadBinary(stream, changed.Entities.data(), changed.Entities.size());
+			ReadBinary(stream, changed.AddedTicks.data(), changed.AddedTicks.size());
+			ReadBinary(stream, changed.ChangedTicks.data(), changed.ChangedTicks.size());
+			return changed;
+		}
+
+		/**
+		 * @brief Overwriting the ticks of a slot
+		 *
+		 * @param slot The slot of the component
+		 * @param addedTick The tick the component was added in
+		 * @param changedTick The tick the component was last added or marked as changed in
+		 */
+		void SetTicks(size_t slot, uint64_t addedTick, uint64_t changedTick)
+		{
+			m_AddedTicks[slot] = addedTick;
+			m_ChangedTicks[slot] = changedTick;
+		}
+
+		/**
+		 * @brief Getting the memory of the entities, ticks and sparse pages of the pool
+		 *
+		 * @return Returns the memory without the components
+		 */
+		ComponentMemory GetIndexMemoryUsage() const
+		{
+			ComponentMemory memory;
+			memory.Count = Size();
+			memory.UsedBytes = Size() * (sizeof(Entity) + 2 * sizeof(uint64_t)) + m_Removed.size() * sizeof(std::pair<uint64_t, Entity>);
+			memory.UnusedBytes = (GetEntities().capacity() - Size()) * sizeof(Entity) + (m_AddedTicks.capacity() + m_ChangedTicks.capacity() - 2 * Size()) * sizeof(uint64_t)
+				+ (m_Removed.capacity() - m_Removed.size()) * sizeof(std::pair<uint64_t, Entity>);
+			memory.SparseBytes = GetSparseMemory();
+			return memory;
+		}
+
+		/**
+		 * @brief Writing the entities and ticks of the pool to a stream
+		 *
+		 * @param stream The stream that is written to
+		 */
+		void SaveEntities(std::ostream& stream) const
+		{
+			uint64_t size = Size();
+			WriteBinary(stream, &size);
+			WriteBinary(stream, GetEntities().data(), Size());
+			WriteBinary(stream, m_AddedTicks.data(), Size());
+			WriteBinary(stream, m_ChangedTicks.data(), Size());
+		}
+
+		/**
+		 * @brief Replacing the entities and ticks of the pool with the ones of a stream
+		 *
+		 * @param stream The stream that is read from
+		 *
+		 * @return Returns the amount of entities
+		 */
+		size_t LoadEntities(std::istream& stream)
+		{
+			uint64_t size = 0;
+			ReadBinary(stream, &size);
+
+			std::vector<Entity> entities(size);
+			ReadBinary(stream, entities.data(), entities.size());
+			SparseSet::Clear();
+			Reserve(entities.size());
+			for (Entity entity : entities)
+				Insert(entity);
+
+			m_AddedTicks.resize(size);
+			m_ChangedTicks.resize(size);
+			ReadBinary(stream, m_AddedTicks.data(), size);
+			ReadBinary(stream, m_ChangedTicks.data(), size);
+			return size;
+		}
+
+		/**
+		 * @brief Removing the ticks of every component and the recorded removals
+		 */
+		void ClearTicks()
+		{
+			m_AddedTicks.clear();
+			m_ChangedTicks.clear();
+			m_Removed.clear();
+		}
+
+		/**
+		 * @brief Appending the ticks of a component added at the end of the pool
+		 *
+		 * @param tick The tick the component was added in
+		 */
+		void InsertTicks(uint64_t tick)
+		{
+			m_AddedTicks.push_back(tick);
+			m_ChangedTicks.push_back(tick);
+		}
+
+		/**
+		 * @brief Removing the ticks of a slot by moving the ticks of the last slot into it
+		 *
+		 * @param slot The slot of the removed component
+		 */
+		void EraseTicks(size_t slot)
+		{
+			m_AddedTicks[slot] = m_AddedTicks.back();
+			m_ChangedTicks[slot] = m_ChangedTicks.back();
+			m_AddedTicks.pop_back();
+			m_ChangedTicks.pop_back();
+		}
+
+		/**
+		 * @brief Exchanging the ticks of two slots
+		 *
+		 * @param left The first slot
+		 * @param right The second slot
+		 */
+		void SwapTicks(size_t left, size_t right)
+		{
+			std::swap(m_AddedTicks[left], m_AddedTicks[right]);
+			std::swap(m_ChangedTicks[left], m_ChangedTicks[right]);
+		}
+
+		/**
+		 * @brief Reserving memory for the ticks of the components in the pool
+		 *
+		 * @param capacity The amount of components the pool can hold without reallocating
+		 */
+		void ReserveTicks(size_t capacity)
+		{
+			m_AddedTicks.reserve(capacity);
+			m_ChangedTicks.reserve(capacity);
+		}
+	};
+
+	/* Contiguous storage for every component of one type, parallel to the entities of the sparse set */
+	template<class T>
+	class ComponentPool : public ComponentPoolBase
+	{
+	private:
+		/* Holds the components back to back in memory allocated by the allocator of the component traits */
+		std::vector<T, typename ComponentAllocator<T>::Type> m_Components;
+
+	public:
+		/**
+		 * @brief Constructing a component for an entity at the end of the pool
+		 *
+		 * @tparam Args The arguments for the class
+		 * @param entity The entity that owns the component
+		 * @param tick The tick the component is added in
+		 * @param args The arguments for the class
+		 *
+		 * @return Returns the created component
+		 */
+		template<typename... Args>
+		T& Emplace(Entity entity, uint64_t tick, Args&&... args)
+		{
+			T& component = m_Components.emplace_back(std::forward<Args>(args)...);
+			Insert(entity);
+			InsertTicks(tick);
+			return component;
+		}
+
+		/**
+		 * @brief Reserving memory for components in the pool
+		 *
+		 * @param capacity The amount of components the pool can hold without reallocating
+		 */
+		void Reserve(size_t capacity)
+		{
+			m_Components.reserve(capacity);
+			SparseSet::Reserve(capacity);
+			ReserveTicks(capacity);
+		}
+
+		/**
+		 * @brief Removing the component of an entity by moving the last component into its slot
+		 *
+		 * @param entity The entity whose component is getting removed
+		 */
+		void Remove(Entity entity) override
+		{
+			size_t slot = Erase(entity);
+			if (slot != m_Components.size() - 1)
+				m_Components[slot] = std::move(m_Components.back());
+			m_Components.pop_back();
+			EraseTicks(slot);
+		}
+
+		/**
+		 * @brief Getting the component of an entity
+		 *
+		 * @param entity The entity that owns the component
+		 *
+		 * @return Returns the corresponding component
+		 */
+		T& Get(Entity entity)
+		{
+			return m_Components[GetSlot(entity)];
+		}
+
+		/**
+		 * @brief Getting the component in a slot
+		 *
+		 * @param slot The slot of the component
+		 *
+		 * @return Returns the corresponding component
+		 */
+		T& GetAt(size_t slot)
+		{
+			return m_Components[slot];
+		}
+
+		/**
+		 * @brief Removing every component from the pool
+		 */
+		void Clear() override
+		{
+			m_Components.clear();
+			SparseSet::Clear();
+			ClearTicks();
+		}
+
+		/**
+		 * @brief Getting the hash that identifies the component class in snapshots
+		 *
+		 * @return Returns the hash
+		 */
+		uint64_t GetTypeHash() const override
+		{
+			return HyperECS::GetTypeHash<T>();
+		}
+
+		/**
+		 * @brief Check if the components can be part of snapshots
+		 *
+		 * @return Returns if the components can be written and read
+		 */
+		bool IsSerializable() const override
+		{
+			return Serializable<T>;
+		}
+
+		/**
+		 * @brief Writing the entities, ticks and components of the pool to a stream
+		 *
+		 * Trivially copyable components are written in one block, others one by one by their component traits.
+		 *
+		 * @param stream The stream that is written to
+		 */
+		void Save(std::ostream& stream) const override
+		{
+			if constexpr (Serializable<T>)
+			{
+				SaveEntities(stream);
+				if constexpr (CustomSerializable<T>)
+				{
+					for (const T& component : m_Components)
+						ComponentTraits<T>::Serialize(stream, component);
+				}
+				else
+				{
+					WriteBinary(stream, m_Components.data(), m_Components.size());
+				}
+			}
+		}
+
+		/**
+		 * @brief Replacing the entities, ticks and components of the pool with the ones of a stream
+		 *
+		 * @param stream The stream that is read from
+		 */
+		void Load(std::istream& stream) override
+		{
+			if constexpr (Serializable<T>)
+			{
+				m_Components.clear();
+				size_t size = LoadEntities(stream);
+				if constexpr (CustomSerializable<T>)
+				{
+					m_Components.reserve(size);
+					for (size_t index = 0; index < size; index++)
+						m_Components.push_back(ComponentTraits<T>::Deserialize(stream));
+				}
+				else
+				{
+					m_Components.resize(size);
+					ReadBinary(stream, m_Components.data(), m_Components.size());
+				}
+			}
+		}
+
+		/**
+		 * @brief Creating an empty pool of the component class
+		 *
+		 * @return Returns the pool
+		 */
+		std::unique_ptr<ComponentPoolBase> CreateEmpty() const override
+		{
+			return std::make_unique<ComponentPool<T>>();
+		}
+
+		/**
+		 * @brief Moving components to the end of a pool of the component class
+		 *
+		 * @param entities Pairs of an entity of this pool and the entity its component is moved to
+		 * @param destination The pool the components are moved to
+		 * @param tick The tick the components are added in at the destination
+		 */
+		void MoveTo(const std::vector<std::pair<Entity, Entity>>& entities, ComponentPoolBase& destination, uint64_t tick) override
+		{
+			if constexpr (std::is_move_constructible_v<T>)
+			{
+				ComponentPool<T>& pool = static_cast<ComponentPool<T>&>(destination);
+				pool.Reserve(pool.Size() + entities.size());
+				for (const std::pair<Entity, Entity>& entity : entities)
+					pool.Emplace(entity.second, tick, std::move(m_Components[GetSlot(entity.first)]));
+			}
+			else
+			{
+				std::cerr << "[HyperECS] Component can not be moved!" << std::endl;
+				__debugbreak();
+			}
+		}
+
+		/**
+		 * @brief Getting the memory the pool holds
+		 *
+		 * @return Returns the memory
+		 */
+		ComponentMemory GetMemoryUsage() const override
+		{
+			ComponentMemory memory = GetIndexMemoryUsage();
+			memory.Name = GetTypeName<T>();
+			memory.Capacity = m_Components.capacity();
+			memory.UsedBytes += m_Components.size() * sizeof(T);
+			memory.UnusedBytes += (m_Components.capacity() - m_Components.size()) * sizeof(T);
+			return memory;
+		}
+
+		/**
+		 * @brief Writing the entities, ticks and components that were added or changed in or after a tick to a stream
+		 *
+		 * @param stream The stream that is written to
+		 * @param sinceTick The first tick whose changes are written
+		 */
+		void SaveChanged(std::ostream& stream, uint64_t sinceTick) const override
+		{
+			if constexpr (Serializable<T>)
+			{
+				std::vector<size_t> slots = SaveChangedEntities(stream, sinceTick);
+				if constexpr (CustomSerializable<T>)
+				{
+					for (size_t slot : slots)
+						ComponentTraits<T>::Serialize(stream, m_Components[slot]);
+				}
+				else
+				{
+					std::vector<T> components;
+					components.reserve(slots.size());
+					for (size_t slot : slots)
+						components.push_back(m_Components[slot]);
+					WriteBinary(stream, components.data(), components.size());
+				}
+			}
+		}
+
+		/**
+		 * @brief Adding or overwriting the components of a stream written by SaveChanged
+		 *
+		 * @param stream The stream that is read from
+		 * @param added The entities whose component was added
+		 */
+		void LoadChanged(std::istream& stream, std::vector<Entity>& added) override
+		{
+			if constexpr (Serializable<T>)
+			{
+				ChangedComponents changed = LoadChangedEntities(stream);
+				std::vector<T> components;
+				if constexpr (CustomSerializable<T>)
+				{
+					components.reserve(changed.Entities.size());
+					for (size_t index = 0; index < changed.Entities.size(); index++)
+						components.push_back(ComponentTraits<T>::Deserialize(stream));
+				}
+				else
+				{
+					components.resize(changed.Entities.size());
+					ReadBinary(stream, components.data(), components.size());
+				}
+
+				for (size_t index = 0; index < components.size(); index++)
+				{
+					size_t slot = GetSlot(changed.Entities[index]);
+					if (slot == Null)
+					{
+						Emplace(changed.Entities[index], 0, std::move(components[index]));
+						slot = Size() - 1;
+						added.push_back(changed.Entities[index]);
+					}
+					else
+					{
+						m_Components[slot] = std::move(components[index]);
+					}
+					SetTicks(slot, changed.AddedTicks[index], changed.ChangedTicks[index]);
+				}
+			}
+		}
+	};
+
+	/* Storage for field components, every field is kept in its own aligned array parallel to the entities of the sparse set */
+	template<class T> requires FieldComponent<T>
+	class ComponentPool<T> : public ComponentPoolBase
+	{
+	private:
+		/* Holds the member pointers to the fields */
+		using FieldTuple = std::remove_cv_t<decltype(ComponentTraits<T>::Fields)>;
+
+		/* Amount of fields of the component */
+		static constexpr size_t FieldCount = std::tuple_size_v<FieldTuple>;
+
+		/* Type of a field */
+		template<size_t Index>
+		using FieldType = typename MemberTraits<std::tuple_element_t<Index, FieldTuple>>::Type;
+
+		/* Aligned array of a field */
+		template<size_t Index>
+		using FieldArray = std::vector<FieldType<Index>, AlignedAllocator<FieldType<Index>, FieldAlignment>>;
+
+		/* Tuple of the arrays of every field */
+		template<size_t... Indices>
+		static std::tuple<FieldArray<Indices>...> MakeFieldArrays(std::index_sequence<Indices...>);
+
+		/* Holds the array of every field */
+		decltype(MakeFieldArrays(std::make_index_sequence<FieldCount>())) m_Fields;
+
+	public:
+		/**
+		 * @brief Constructing a component for an entity and appending its fields to the arrays
+		 *
+		 * @tparam Args The arguments for the class
+		 * @param entity The entity that owns the component
+		 * @param tick The tick the component is added in
+		 * @param args The arguments for the class
+		 *
+		 * @return Returns the reference to the created component
+		 */
+		template<typename... Args>
+		FieldReference<T> Emplace(Entity entity, uint64_t tick, Args&&... args)
+		{
+			T component(std::forward<Args>(args)...);
+			EachField([&](auto& array, auto field) { array.push_back(component.*field); });
+			Insert(entity);
+			InsertTicks(tick);
+			return FieldReference<T>(this, Size() - 1);
+		}
+
+		/**
+		 * @brief Reserving memory for components in the pool
+		 *
+		 * @param capacity The amount of components the pool can hold without reallocating
+		 */
+		void Reserve(size_t capacity)
+		{
+			EachField([&](auto& array, auto) { array.reserve(capacity); });
+			SparseSet::Reserve(capacity);
+			ReserveTicks(capacity);
+		}
+
+		/**
+		 * @brief Removing the component of an entity by moving the fields of the last component into its slot
+		 *
+		 * @param entity The entity whose component is getting removed
+		 */
+		void Remove(Entity entity) override
+		{
+			size_t slot = Erase(entity);
+			EachField([&](auto& array, auto)
+			{
+				array[slot] = array.back();
+				array.pop_back();
+			});
+			EraseTicks(slot);
+		}
+
+		/**
+		 * @brief Getting the component of an entity
+		 *
+		 * @param entity The entity that owns the component
+		 *
+		 * @return Returns the reference to the component
+		 */
+		FieldReference<T> Get(Entity entity)
+		{
+			return FieldReference<T>(this, GetSlot(entity));
+		}
+
+		/**
+		 * @brief Getting the component in a slot
+		 *
+		 * @param slot The slot of the component
+		 *
+		 * @return Returns the reference to the component
+		 */
+		FieldReference<T> GetAt(size_t slot)
+		{
+			return FieldReference<T>(this, slot);
+		}
+
+		/**
+		 * @brief Assembling a copy of the component in a slot from its fields
+		 *
+		 * @param slot The slot of the component
+		 *
+		 * @return Returns the copy of the component
+		 */
+		T Gather(size_t slot) const
+		{
+			T component{};
+			EachField([&](const auto& array, auto field) { component.*field = array[slot]; });
+			return component;
+		}
+
+		/**
+		 * @brief Writing the fields of a component into a slot
+		 *
+		 * @param slot The slot of the component
+		 * @param component The component whose fields are written
+		 */
+		void Scatter(size_t slot, const T& component)
+		{
+			EachField([&](auto& array, auto field) { array[slot] = component.*field; });
+		}
+
+		/**
+		 * @brief Getting the array of a field
+		 *
+		 * @tparam Member The member pointer of the field
+		 *
+		 * @return Returns the first element of the array, aligned to FieldAlignment
+		 */
+		template<auto Member>
+		auto* GetFieldData()
+		{
+			constexpr size_t index = GetFieldIndex<Member>();
+			static_assert(index < FieldCount, "Member is not a field of the component!");
+			return std::get<index>(m_Fields).data();
+		}
+
+		/**
+		 * @brief Exchanging the components and ticks of two slots
+		 *
+		 * @param left The first slot
+		 * @param right The second slot
+		 */
+		void SwapSlots(size_t left, size_t right)
+		{
+			Swap(left, right);
+			SwapTicks(left, right);
+			EachField([&](auto& array, auto) { std::swap(array[left], array[right]); });
+		}
+
+		/**
+		 * @brief Removing every component from the pool
+		 */
+		void Clear() override
+		{
+			EachField([](auto& array, auto) { array.clear(); });
+			SparseSet::Clear();
+			ClearTicks();
+		}
+
+		/**
+		 * @brief Getting the hash that identifies the component class in snapshots
+		 *
+		 * @return Returns the hash
+		 */
+		uint64_t GetTypeHash() const override
+		{
+			return HyperECS::GetTypeHash<T>();
+		}
+
+		/**
+		 * @brief Check if the components can be part of snapshots
+		 *
+		 * @return Returns if the components can be written and read
+		 */
+		bool IsSerializable() const override
+		{
+			return true;
+		}
+
+		/**
+		 * @brief Writing the entities, ticks and fields of the pool to a stream, every field array in one block
+		 *
+		 * @param stream The stream that is written to
+		 */
+		void Save(std::ostream& stream) const override
+		{
+			SaveEntities(stream);
+			EachField([&](const auto& array, auto) { WriteBinary(stream, array.data(), array.size()); });
+		}
+
+		/**
+		 * @brief Replacing the entities, ticks and fields of the pool with the ones of a stream
+		 *
+		 * @param stream The stream that is read from
+		 */
+		void Load(std::istream& stream) override
+		{
+			size_t size = LoadEntities(stream);
+			EachField([&](auto& array, auto)
+			{
+				array.resize(size);
+				ReadBinary(stream, array.data(), array.size());
+			});
+		}
+
+		/**
+		 * @brief Creating an empty pool of the field component class
+		 *
+		 * @return Returns the pool
+		 */
+		std::unique_ptr<ComponentPoolBase> CreateEmpty() const override
+		{
+			return std::make_unique<ComponentPool<T>>();
+		}
+
+		/**
+		 * @brief Gathering components and appending their fields to a pool of the field component class
+		 *
+		 * @param entities Pairs of an entity of this pool and the entity its component is moved to
+		 * @param destination The pool the components are moved to
+		 * @param tick The tick the components are added in at the destination
+		 */
+		void MoveTo(const std::vector<std::pair<Entity, Entity>>& entities, ComponentPoolBase& destination, uint64_t tick) override
+		{
+			ComponentPool<T>& pool = static_cast<ComponentPool<T>&>(destination);
+			pool.Reserve(pool.Size() + entities.size());
+			for (const std::pair<Entity, Entity>& entity : entities)
+				pool.Emplace(entity.second, tick, Gather(GetSlot(entity.first)));
+		}
+
+		/**
+		 * @brief Getting the memory the pool holds, summed over the field arrays
+		 *
+		 * @return Returns the memory
+		 */
+		ComponentMemory GetMemoryUsage() const override
+		{
+			ComponentMemory memory = GetIndexMemoryUsage();
+			memory.Name = GetTypeName<T>();
+			memory.Capacity = std::get<0>(m_Fields).capacity();
+			EachField([&](const auto& array, auto)
+			{
+				using Field = typename std::remove_cvref_t<decltype(array)>::value_type;
+				memory.UsedBytes += array.size() * sizeof(Field);
+				memory.UnusedBytes += (array.capacity() - array.size()) * sizeof(Field);
+			});
+			return memory;
+		}
+
+		/**
+		 * @brief Writing the entities, ticks and fields of the components added or changed in or after a tick to a stream, every field in one block
+		 *
+		 * @param stream The stream that is written to
+		 * @param sinceTick The first tick whose changes are written
+		 */
+		void SaveChanged(std::ostream& stream, uint64_t sinceTick) const override
+		{
+			std::vector<size_t> slots = SaveChangedEntities(stream, sinceTick);
+			EachField([&](const auto& array, auto)
+			{
+				std::remove_cvref_t<decltype(array)> values;
+				values.reserve(slots.size());
+				for (size_t slot : slots)
+					values.push_back(array[slot]);
+				WriteBinary(stream, values.data(), values.size());
+			});
+		}
+
+		/**
+		 * @brief Adding or overwriting the components of a stream written by SaveChanged
+		 *
+		 * @param stream The stream that is read from
+		 * @param added The entities whose component was added
+		 */
+		void LoadChanged(std::istream& stream, std::vector<Entity>& added) override
+		{
+			ChangedComponents changed = LoadChangedEntities(stream);
+			std::vector<T> components(changed.Entities.size());
+			EachField([&](auto& array, auto field)
+			{
+				std::remove_cvref_t<decltype(array)> values(components.size());
+				ReadBinary(stream, values.data(), values.size());
+				for (size_t index = 0; index < components.size(); index++)
+					components[index].*field = values[index];
+			});
+
+			for (size_t index = 0; index < components.size(); index++)
+			{
+				size_t slot = GetSlot(changed.Entities[index]);
+				if (slot == Null)
+				{
+					Emplace(changed.Entities[index], 0, components[index]);
+					slot = Size() - 1;
+					added.push_back(changed.Entities[index]);
+				}
+				else
+				{
+					Scatter(slot, components[index]);
+				}
+				SetTicks(slot, changed.AddedTicks[index], changed.ChangedTicks[index]);
+			}
+		}
+
+	private:
+		/**
+		 * @brief Calling a function for every field array with the member pointer of the field
+		 *
+		 * @tparam Function The type of the function, invocable with an array and a member pointer
+		 * @param function Function that is getting called for every field
+		 */
+		template<class Function>
+		void EachField(Function&& function)
+		{
+			[&]<size_t... Indices>(std::index_sequence<Indices...>)
+			{
+				(function(std::get<Indices>(m_Fields), std::get<Indices>(ComponentTraits<T>::Fields)), ...);
+			}(std::make_index_sequence<FieldCount>());
+		}
+
+		/**
+		 * @brief Calling a function for every field array with the member pointer of the field
+		 *
+		 * @tparam Function The type of the function, invocable with an array and a member pointer
+		 * @param function Function that is getting called for every field
+		 */
+		template<class Function>
+		void EachField(Function&& function) const
+		{
+			[&]<size_t... Indices>(std::index_sequence<Indices...>)
+			{
+				(function(std::get<Indices>(m_Fields), std::get<Indices>(ComponentTraits<T>::Fields)), ...);
+			}(std::make_index_sequence<FieldCount>());
+		}
+
+		/**
+		 * @brief Getting the index of a field
+		 *
+		 * @tparam Member The member pointer of the field
+		 *
+		 * @return Returns the index or FieldCount if the member is not a field
+		 */
+		template<auto Member>
+		static constexpr size_t GetFieldIndex()
+		{
+			size_t index = FieldCount;
+			[&]<size_t... Indices>(std::index_sequence<Indices...>)
+			{
+				auto matches = [](auto field)
+				{
+					if constexpr (std::is_same_v<decltype(field), decltype(Member)>)
+						return field == Member;
+					else
+						return false;
+				};
+				((matches(std::get<Indices>(ComponentTraits<T>::Fields)) ? (index = Indices, true) : false) || ...);
+			}(std::make_index_sequence<FieldCount>());
+			return index;
+		}
+	};
+
+	/* Reference to a field component, its fields are not stored together so it refers to the slot in the pool */
+	template<class T>
+	class FieldReference
+	{
+	private:
+		/* The pool of the component */
+		ComponentPool<T>* m_Pool;
+
+		/* The slot of the component */
+		size_t m_Slot;
+
+	public:
+		/**
+		 * @brief Referring to the component in a slot
+		 *
+		 * @param pool The pool of the component
+		 * @param slot The slot of the component
+		 */
+		FieldReference(ComponentPool<T>* pool, size_t slot)
+			: m_Pool(pool), m_Slot(slot) {}
+
+		/**
+		 * @brief Getting a field of the component
+		 *
+		 * @tparam Member The member pointer of the field
+		 *
+		 * @return Returns the field
+		 */
+		template<auto Member>
+		auto& Get() const
+		{
+			return m_Pool->template GetFieldData<Member>()[m_Slot];
+		}
+
+		/**
+		 * @brief Assembling a copy of the component
+		 *
+		 * @return Returns the copy of the component
+		 */
+		operator T() const
+		{
+			return m_Pool->Gather(m_Slot);
+		}
+
+		/**
+		 * @brief Writing every field of the component
+		 *
+		 * @param component The component whose fields are written
+		 *
+		 * @return Returns the reference
+		 */
+		const FieldReference& operator=(const T& component) const
+		{
+			m_Pool->Scatter(m_Slot, component);
+			return *this;
+		}
+	};
+
+	/* Aligned spans over the fields of field components, parallel to the entities passed to EachFields */
+	template<class T>
+	class FieldSpans
+	{
+	private:
+		/* The pool of the components */
+		ComponentPool<T>* m_Pool;
+
+		/* The amount of components the spans cover */
+		size_t m_Size;
+
+	public:
+		/**
+		 * @brief Covering the first components of a pool
+		 *
+		 * @param pool The pool of the components
+		 * @param size The amount of components the spans cover
+		 */
+		FieldSpans(ComponentPool<T>* pool, size_t size)
+			: m_Pool(pool), m_Size(size) {}
+
+		/**
+		 * @brief Getting the span of a field, its data is aligned to FieldAlignment
+		 *
+		 * @tparam Member The member pointer of the field
+		 *
+		 * @return Returns the span
+		 */
+		template<auto Member>
+		auto Get() const
+		{
+			auto* data = m_Pool->template GetFieldData<Member>();
+			return std::span<std::remove_pointer_t<decltype(data)>>(std::assume_aligned<FieldAlignment>(data), m_Size);
+		}
+
+		/**
+		 * @brief Getting the amount of components the spans cover
+		 *
+		 * @return Returns the amount of components
+		 */
+		size_t Size() const
+		{
+			return m_Size;
+		}
+	};
+
+	/* Entities that have every component of a signature, updated whenever one of the components is added or removed */
+	class Group : public SparseSet
+	{
+	private:
+		/* Holds the pools of the components of the signature */
+		std::vector<ComponentPoolBase*> m_Pools;
+
+	public:
+		/**
+		 * @brief Creating a group and collecting the entities that already match it
+		 *
+		 * @param pools The pools of the components of the signature
+		 */
+		Group(std::vector<ComponentPoolBase*> pools)
+			: m_Pools(std::move(pools))
+		{
+			Rebuild();
+
+			for (ComponentPoolBase* pool : m_Pools)
+				pool->AddGroup(this);
+		}
+
+		/**
+		 * @brief Recollecting the matching entities from the pools, needed after the pools were replaced as a whole
+		 */
+		void Rebuild()
+		{
+			Clear();
+
+			ComponentPoolBase* smallest = *std::min_element(m_Pools.begin(), m_Pools.end(), [](ComponentPoolBase* left, ComponentPoolBase* right) { return left->Size() < right->Size(); });
+			for (Entity entity : smallest->GetEntities())
+				if (Matches(entity))
+					Insert(entity);
+		}
+
+		/**
+		 * @brief Check if an entity has every component of the signature
+		 *
+		 * @param entity The entity that is getting checked
+		 *
+		 * @return Returns if the entity matches
+		 */
+		bool Matches(Entity entity) const
+		{
+			for (ComponentPoolBase* pool : m_Pools)
+				if (!pool->Contains(entity))
+					return false;
+			return true;
+		}
+
+		/**
+		 * @brief Inserting an entity after one of its components was added, if it matches now
+		 *
+		 * @param entity The entity that got the component
+		 */
+		void OnComponentAdded(Entity entity)
+		{
+			if (!Contains(entity) && Matches(entity))
+				Insert(entity);
+		}
+
+		/**
+		 * @brief Erasing an entity before one of its components is removed
+		 *
+		 * @param entity The entity that loses the component
+		 */
+		void OnComponentRemoved(Entity entity)
+		{
+			if (Contains(entity))
+				Erase(entity);
+		}
+
+		/**
+		 * @brief Getting the memory of the matching entities and the pools of the signature
+		 *
+		 * @return Returns the size in bytes
+		 */
+		size_t GetMemory() const
+		{
+			return SparseSet::GetMemory() + m_Pools.capacity() * sizeof(ComponentPoolBase*);
+		}
+	};
+
+	/* Query term that only matches entities without the component, it is not passed to the function */
+	template<class T>
+	struct Without
+	{
+	};
+
+	/* Query term that passes the component if the entity has it, a pointer or for field components a std::optional */
+	template<class T>
+	struct Optional
+	{
+	};
+
+	/* Query term that only matches entities whose component was added or marked as changed since a tick */
+	template<class T>
+	struct Changed
+	{
+	};
+
+	/* Component class and role of a query term, plain component classes are required */
+	template<class Term>
+	struct QueryTerm
+	{
+		using Component = Term;
+		using Argument = ComponentReference<Term>;
+		static constexpr bool IsRequired = true;
+		static constexpr bool IsExcluded = false;
+		static constexpr bool IsChanged = false;
+	};
+
+	template<class T>
+	struct QueryTerm<Without<T>>
+	{
+		using Component = T;
+		using Argument = void;
+		static constexpr bool IsRequired = false;
+		static constexpr bool IsExcluded = true;
+		static constexpr bool IsChanged = false;
+	};
+
+	template<class T>
+	struct QueryTerm<Optional<T>>
+	{
+		using Component = T;
+		using Argument = std::conditional_t<FieldComponent<T>, std::optional<FieldReference<T>>, T*>;
+		static constexpr bool IsRequired = false;
+		static constexpr bool IsExcluded = false;
+		static constexpr bool IsChanged = false;
+	};
+
+	template<class T>
+	struct QueryTerm<Changed<T>>
+	{
+		using Component = T;
+		using Argument = ComponentReference<T>;
+		static constexpr bool IsRequired = true;
+		static constexpr bool IsExcluded = false;
+		static constexpr bool IsChanged = true;
+	};
+
+	/* Entities matching required, excluded, optional and changed components, iterated from the smallest required pool */
+	template<class... Terms>
+	class ComponentQuery
+	{
+	private:
+		static_assert((QueryTerm<Terms>::IsRequired || ...), "Query needs at least one required component!");
+
+		/* Holds the pools of the components of the terms, nullptr for classes without a pool */
+		std::tuple<ComponentPool<typename QueryTerm<Terms>::Component>*...> m_Pools;
+
+		/* Changed terms match components that were added or changed in this tick or later */
+		uint64_t m_SinceTick;
+
+	public:
+		/**
+		 * @brief Creating the query
+		 *
+		 * @param pools The pools of the components of the terms
+		 * @param sinceTick The tick changed terms compare against
+		 */
+		ComponentQuery(std::tuple<ComponentPool<typename QueryTerm<Terms>::Component>*...> pools, uint64_t sinceTick)
+			: m_Pools(pools), m_SinceTick(sinceTick) {}
+
+		/**
+		 * @brief Calling a function for every matching entity
+		 *
+		 * Only the smallest required pool is walked, every other term is a sparse lookup. Removing the component
+		 * of the current entity inside the function is allowed.
+		 *
+		 * @tparam Function The type of the function, invocable with an entity and the arguments of every term but Without
+		 * @param function Function that is getting called for every matching entity
+		 */
+		template<class Function>
+		void Each(Function&& function) const
+		{
+			const ComponentPoolBase* driver = GetSmallestPool();
+			if (driver == nullptr)
+				return;
+
+			const std::vector<Entity>& entities = driver->GetEntities();
+
+			std::array<size_t, sizeof...(Terms)> slots;
+			for (size_t index = entities.size(); index-- > 0;)
+				if (Match(entities[index], slots, std::index_sequence_for<Terms...>()))
+					Invoke(function, entities[index], slots, std::index_sequence_for<Terms...>());
+		}
+
+		/**
+		 * @brief Getting every matching entity
+		 *
+		 * @return Returns the matching entities
+		 */
+		std::vector<Entity> GetEntities() const
+		{
+			std::vector<Entity> entities;
+			const ComponentPoolBase* driver = GetSmallestPool();
+			if (driver == nullptr)
+				return entities;
+
+			std::array<size_t, sizeof...(Terms)> slots;
+			for (Entity entity : driver->GetEntities())
+				if (Match(entity, slots, std::index_sequence_for<Terms...>()))
+					entities.push_back(entity);
+			return entities;
+		}
+
+	private:
+		/**
+		 * @brief Getting the smallest pool of the required terms
+		 *
+		 * @return Returns the pool or nullptr if a required component has no pool
+		 */
+		const ComponentPoolBase* GetSmallestPool() const
+		{
+			const ComponentPoolBase* smallest = nullptr;
+			bool isEmpty = false;
+			[&]<size_t... Indices>(std::index_sequence<Indices...>)
+			{
+				auto visit = [&](const ComponentPoolBase* pool, bool isRequired)
+				{
+					if (!isRequired)
+						return;
+					if (pool == nullptr)
+						isEmpty = true;
+					else if (smallest == nullptr || pool->Size() < smallest->Size())
+						smallest = pool;
+				};
+				(visit(std::get<Indices>(m_Pools), QueryTerm<Terms>::IsRequired), ...);
+			}(std::index_sequence_for<Terms...>());
+			return isEmpty ? nullptr : smallest;
+		}
+
+		/**
+		 * @brief Check if an entity matches every term, looking up the slots of its components
+		 *
+		 * @param entity The entity that is getting checked
+		 * @param slots The slots of the components of the entity, Null for missing optional components
+		 *
+		 * @return Returns if the entity matched
+		 */
+		template<size_t... Indices>
+		bool Match(Entity entity, std::array<size_t, sizeof...(Terms)>& slots, std::index_sequence<Indices...>) const
+		{
+			return (MatchTerm<Indices, Terms>(entity, slots[Indices]) && ...);
+		}
+
+		/**
+		 * @brief Check if an entity matches a term, looking up the slot of its component
+		 *
+		 * @tparam Index The index of the term
+		 * @tparam Term The term
+		 * @param entity The entity that is getting checked
+		 * @param slot The slot of the component of the entity
+		 *
+		 * @return Returns if the entity matched
+		 */
+		template<size_t Index, class Term>
+		bool MatchTerm(Entity entity, size_t& slot) const
+		{
+			const auto* pool = std::get<Index>(m_Pools);
+			slot = pool != nullptr ? pool->GetSlot(entity) : SparseSet::Null;
+			if constexpr (QueryTerm<Term>::IsExcluded)
+				return slot == SparseSet::Null;
+			else if constexpr (QueryTerm<Term>::IsChanged)
+				return slot != SparseSet::Null && pool->GetChangedTick(slot) >= m_SinceTick;
+			else if constexpr (QueryTerm<Term>::IsRequired)
+				return slot != SparseSet::Null;
+			else
+				return true;
+		}
+
+		/**
+		 * @brief Calling the function with an entity and the arguments of its terms
+		 *
+		 * @tparam Function The type of the function
+		 * @param function The function that is called
+		 * @param entity The entity
+		 * @param slots The slots of the components of the entity
+		 */
+		template<class Function, size_t... Indices>
+		void Invoke(Function& function, Entity entity, const std::array<size_t, sizeof...(Terms)>& slots, std::index_sequence<Indices...>) const
+		{
+			std::apply(function, std::tuple_cat(std::tuple<Entity>(entity), GetArgument<Indices, Terms>(slots[Indices])...));
+		}
+
+		/**
+		 * @brief Getting the argument of a term, nothing for excluded components
+		 *
+		 * @tparam Index The index of the term
+		 * @tparam Term The term
+		 * @param slot The slot of the component
+		 *
+		 * @return Returns a tuple with the argument or an empty tuple
+		 */
+		template<size_t Index, class Term>
+		auto GetArgument(size_t slot) const
+		{
+			using Argument = typename QueryTerm<Term>::Argument;
+			auto* pool = std::get<Index>(m_Pools);
+			if constexpr (QueryTerm<Term>::IsExcluded)
+				return std::tuple<>();
+			else if constexpr (QueryTerm<Term>::IsRequired)
+				return std::tuple<Argument>(pool->GetAt(slot));
+			else if constexpr (FieldComponent<typename QueryTerm<Term>::Component>)
+				return std::tuple<Argument>(slot != SparseSet::Null ? Argument(pool->GetAt(slot)) : std::nullopt);
+			else
+				return std::tuple<Argument>(slot != SparseSet::Null ? &pool->GetAt(slot) : nullptr);
+		}
+	};
+
+	/* Range over the entities with specified components for range based for loops */
+	template<class... T>
+	class ComponentView
+	{
+	private:
+		/* The entities that are visited, either a pool or a group */
+		const std::vector<Entity>* m_Entities;
+
+		/* Holds the pools of the components */
+		std::tuple<ComponentPool<T>*...> m_Pools;
+
+	public:
+		/* Iterator that yields the entity and references to its components */
+		class Iterator
+		{
+		private:
+			/* The view that is iterated */
+			const ComponentView* m_View;
+
+			/* The current position in the entities of the view */
+			size_t m_Index;
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using difference_type = std::ptrdiff_t;
+			using value_type = std::tuple<Entity, ComponentReference<T>...>;
+			using pointer = void;
+			using reference = value_type;
+
+			Iterator()
+				: m_View(nullptr), m_Index(0) {}
+
+			Iterator(const ComponentView* view, size_t index)
+				: m_View(view), m_Index(index) {}
+
+			/**
+			 * @brief Getting the entity and its components at the current position
+			 *
+			 * @return Returns a tuple of the entity and references to the components
+			 */
+			value_type operator*() const
+			{
+				Entity entity = (*m_View->m_Entities)[m_Index];
+				if constexpr (sizeof...(T) == 1)
+					return value_type(entity, std::get<0>(m_View->m_Pools)->GetAt(m_Index));
+				else
+					return value_type(entity, std::get<ComponentPool<T>*>(m_View->m_Pools)->Get(entity)...);
+			}
+
+			Iterator& operator++()
+			{
+				m_Index++;
+				return *this;
+			}
+
+			Iterator operator++(int)
+			{
+				Iterator iterator = *this;
+				m_Index++;
+				return iterator;
+			}
+
+			bool operator==(const Iterator& other) const { return m_Index == other.m_Index; }
+		};
+
+		/**
+		 * @brief Creating a view over entities and the pools of their components
+		 *
+		 * @param entities The entities that are visited
+		 * @param pools The pools of the components
+		 */
+		ComponentView(const std::vector<Entity>& entities, ComponentPool<T>*... pools)
+			: m_Entities(&entities), m_Pools(pools...) {}
+
+		Iterator begin() const { return Iterator(this, 0); }
+		Iterator end() const { return Iterator(this, m_Entities->size()); }
+
+		/**
+		 * @brief Getting the amount of entities in the view
+		 *
+		 * @return Returns the amount of entities
+		 */
+		size_t Size() const
+		{
+			return m_Entities->size();
+		}
+	};
+
+	/* Parent and child relations of entities, kept in a breadth first order sorted by depth for linear traversal */
+	class Hierarchy : public SparseSet
+	{
+	private:
+		/* Relations of an entity, missing relations are the null entity */
+		struct Node
+		{
+			/* The parent of the entity */
+			Entity Parent;
+
+			/* The first child of the entity */
+			Entity FirstChild;
+
+			/* The previous child of the same parent */
+			Entity PreviousSibling;
+
+			/* The next child of the same parent */
+			Entity NextSibling;
+		};
+
+		/* Holds the relations of every entity that has a parent or children, at the slot of the entity */
+		std::vector<Node> m_Nodes;
+
+		/* Holds the entities sorted by depth, parents come before their children */
+		std::vector<Entity> m_Order;
+
+		/* Holds the index of the parent in m_Order of every entity in m_Order, Null for roots */
+		std::vector<size_t> m_ParentIndices;
+
+		/* Holds the index in m_Order where every depth begins, followed by the end of the last depth */
+		std::vector<size_t> m_Levels;
+
+		/* If the relations changed since the order was sorted */
+		bool m_IsDirty = false;
+
+	public:
+		/**
+		 * @brief Attaching an entity to a parent, the entity is detached from its previous parent
+		 *
+		 * @param child The entity that is getting attached
+		 * @param parent The new parent of the entity
+		 */
+		void SetParent(Entity child, Entity parent)
+		{
+			Entity previous = GetParent(child);
+			Detach(child);
+			if (previous.IsHandleValid() && !(previous == parent))
+				Release(previous);
+
+			Assure(child);
+			Assure(parent);
+
+			Node& node = m_Nodes[GetSlot(child)];
+			Node& parentNode = m_Nodes[GetSlot(parent)];
+			node.Parent = parent;
+			node.NextSibling = parentNode.FirstChild;
+			if (parentNode.FirstChild.IsHandleValid())
+				m_Nodes[GetSlot(parentNode.FirstChild)].PreviousSibling = child;
+			parentNode.FirstChild = child;
+			m_IsDirty = true;
+		}
+
+		/**
+		 * @brief Detaching an entity from its parent, the entity becomes a root
+		 *
+		 * @param child The entity that is getting detached
+		 */
+		void RemoveParent(Entity child)
+		{
+			Entity parent = GetParent(child);
+			Detach(child);
+			Release(child);
+			if (parent.IsHandleValid())
+				Release(parent);
+		}
+
+		/**
+		 * @brief Removing an entity from the hierarchy, its children become roots
+		 *
+		 * @param entity The entity that is getting removed
+		 */
+		void Remove(Entity entity)
+		{
+			if (!Contains(entity))
+				return;
+
+			Entity parent = GetParent(entity);
+			Detach(entity);
+
+			Entity child = m_Nodes[GetSlot(entity)].FirstChild;
+			while (child.IsHandleValid())
+			{
+				Node& childNode = m_Nodes[GetSlot(child)];
+				Entity next = childNode.NextSibling;
+				childNode.Parent = Entity({ 0 });
+				childNode.PreviousSibling = Entity({ 0 });
+				childNode.NextSibling = Entity({ 0 });
+				Release(child);
+				child = next;
+			}
+
+			m_Nodes[GetSlot(entity)].FirstChild = Entity({ 0 });
+			Release(entity);
+			if (parent.IsHandleValid())
+				Release(parent);
+		}
+
+		/**
+		 * @brief Getting the parent of an entity
+		 *
+		 * @param child The entity whose parent is searched for
+		 *
+		 * @return Returns the parent or the null entity if the entity is a root
+		 */
+		Entity GetParent(Entity child) const
+		{
+			size_t slot = GetSlot(child);
+			return slot != Null ? m_Nodes[slot].Parent : Entity({ 0 });
+		}
+
+		/**
+		 * @brief Check if an entity is an ancestor of another
+		 *
+		 * @param ancestor The entity that is searched for in the parents
+		 * @param entity The entity whose parents are getting checked
+		 *
+		 * @return Returns if the entity was found in the parents
+		 */
+		bool IsAncestor(Entity ancestor, Entity entity) const
+		{
+			for (Entity parent = GetParent(entity); parent.IsHandleValid(); parent = GetParent(parent))
+				if (parent == ancestor)
+					return true;
+			return false;
+		}
+
+		/**
+		 * @brief Calling a function for every child of an entity
+		 *
+		 * @tparam Function The type of the function, invocable with an entity
+		 * @param parent The entity whose children are visited
+		 * @param function Function that is getting called for every child
+		 */
+		template<class Function>
+		void EachChild(Entity parent, Function&& function) const
+		{
+			size_t slot = GetSlot(parent);
+			if (slot == Null)
+				return;
+
+			for (Entity child = m_Nodes[slot].FirstChild; child.IsHandleValid();)
+			{
+				Entity next = m_Nodes[GetSlot(child)].NextSibling;
+				function(child);
+				child = next;
+			}
+		}
+
+		/**
+		 * @brief Sorting the entities by depth if the relations changed since the last sort
+		 */
+		void Sort()
+		{
+			if (!m_IsDirty)
+				return;
+
+			m_Order.clear();
+			m_ParentIndices.clear();
+			m_Levels.clear();
+			m_Order.reserve(Size());
+			m_ParentIndices.reserve(Size());
+
+			const std::vector<Entity>& entities = GetEntities();
+			for (size_t slot = 0; slot < entities.size(); slot++)
+				if (!m_Nodes[slot].Parent.IsHandleValid())
+				{
+					m_Order.push_back(entities[slot]);
+					m_ParentIndices.push_back(Null);
+				}
+
+			m_Levels.push_back(0);
+			for (size_t begin = 0; begin < m_Order.size();)
+			{
+				size_t end = m_Order.size();
+				m_Levels.push_back(end);
+				for (size_t index = begin; index < end; index++)
+					for (Entity child = m_Nodes[GetSlot(m_Order[index])].FirstChild; child.IsHandleValid(); child = m_Nodes[GetSlot(child)].NextSibling)
+					{
+						m_Order.push_back(child);
+						m_ParentIndices.push_back(index);
+					}
+				begin = end;
+			}
+
+			m_IsDirty = false;
+		}
+
+		/**
+		 * @brief Getting the entities sorted by depth, up to date after Sort
+		 *
+		 * @return Returns the entities, parents come before their children
+		 */
+		const std::vector<Entity>& GetOrder() const
+		{
+			return m_Order;
+		}
+
+		/**
+		 * @brief Getting the index of the parent of every entity in the order, up to date after Sort
+		 *
+		 * @return Returns the indices into the order, Null for roots
+		 */
+		const std::vector<size_t>& GetParentIndices() const
+		{
+			return m_ParentIndices;
+		}
+
+		/**
+		 * @brief Getting the amount of depths, up to date after Sort
+		 *
+		 * @return Returns the amount of depths
+		 */
+		size_t GetLevelCount() const
+		{
+			return m_Levels.empty() ? 0 : m_Levels.size() - 1;
+		}
+
+		/**
+		 * @brief Getting the range of the order that holds the entities of a depth, up to date after Sort
+		 *
+		 * @param depth The depth, zero for roots
+		 *
+		 * @return Returns the index of the first entity and the index past the last entity of the depth
+		 */
+		std::pair<size_t, size_t> GetLevel(size_t depth) const
+		{
+			return { m_Levels[depth], m_Levels[depth + 1] };
+		}
+
+		/**
+		 * @brief Removing every relation
+		 */
+		void Clear()
+		{
+			SparseSet::Clear();
+			m_Nodes.clear();
+			m_Order.clear();
+			m_ParentIndices.clear();
+			m_Levels.clear();
+			m_IsDirty = false;
+		}
+
+		/**
+		 * @brief Getting the memory of the relations and their order
+		 *
+		 * @return Returns the size in bytes
+		 */
+		size_t GetMemory() const
+		{
+			return SparseSet::GetMemory() + m_Nodes.capacity() * sizeof(Node) + m_Order.capacity() * sizeof(Entity)
+				+ m_ParentIndices.capacity() * sizeof(size_t) + m_Levels.capacity() * sizeof(size_t);
+		}
+
+	private:
+		/**
+		 * @brief Inserting an entity without relations if it is not part of the hierarchy yet
+		 *
+		 * @param entity The entity that is getting inserted
+		 */
+		void Assure(Entity entity)
+		{
+			if (Contains(entity))
+				return;
+
+			Insert(entity);
+			m_Nodes.push_back(Node({ Entity({ 0 }), Entity({ 0 }), Entity({ 0 }), Entity({ 0 }) }));
+			m_IsDirty = true;
+		}
+
+		/**
+		 * @brief Unlinking an entity from its parent and siblings
+		 *
+		 * @param child The entity that is getting unlinked
+		 */
+		void Detach(Entity child)
+		{
+			size_t slot = GetSlot(child);
+			if (slot == Null || !m_Nodes[slot].Parent.IsHandleValid())
+				return;
+
+			Node node = m_Nodes[slot];
+			if (node.PreviousSibling.IsHandleValid())
+				m_Nodes[GetSlot(node.PreviousSibling)].NextSibling = node.NextSibling;
+			else
+				m_Nodes[GetSlot(node.Parent)].FirstChild = node.NextSibling;
+			if (node.NextSibling.IsHandleValid())
+				m_Nodes[GetSlot(node.NextSibling)].PreviousSibling = node.PreviousSibling;
+
+			m_Nodes[slot].Parent = Entity({ 0 });
+			m_Nodes[slot].PreviousSibling = Entity({ 0 });
+			m_Nodes[slot].NextSibling = Entity({ 0 });
+			m_IsDirty = true;
+		}
+
+		/**
+		 * @brief Erasing an entity that has neither a parent nor children by moving the last node into its slot
+		 *
+		 * @param entity The entity that is getting erased
+		 */
+		void Release(Entity entity)
+		{
+			size_t slot = GetSlot(entity);
+			if (slot == Null || m_Nodes[slot].Parent.IsHandleValid() || m_Nodes[slot].FirstChild.IsHandleValid())
+				return;
+
+			Erase(entity);
+			if (slot != m_Nodes.size() - 1)
+				m_Nodes[slot] = m_Nodes.back();
+			m_Nodes.pop_back();
+			m_IsDirty = true;
+		}
+	};
+
+	/* Base class of a resource, so resources of every class can be held in one array */
+	class ResourceBase
+	{
+	public:
+		virtual ~ResourceBase() = default;
+	};
+
+	/* Holds a single instance of a class that belongs to no entity, like the time, configuration or input state */
+	template<class T>
+	class Resource : public ResourceBase
+	{
+	public:
+		/* The resource */
+		T Value;
+
+	public:
+		/**
+		 * @brief Constructing the resource
+		 *
+		 * @tparam Args The arguments for the class
+		 * @param args The arguments for the class
+		 */
+		template<typename... Args>
+		explicit Resource(Args&&... args)
+			: Value(std::forward<Args>(args)...) {}
+	};
+
+	/* Pool of worker threads with one job queue per worker, idle workers steal jobs from the queues of the others */
+	class ThreadPool
+	{
+	private:
+		/* Job queue of a worker */
+		struct WorkerQueue
+		{
+			/* Mutex & Lock for the jobs */
+			std::mutex JobLock;
+
+			/* Holds the jobs, the owner takes from the back and thieves from the front */
+			std::deque<std::function<void()>> Jobs;
+		};
+
+		/* Holds the worker threads */
+		std::vector<std::thread> m_Workers;
+
+		/* Holds the job queue of every worker */
+		std::vector<std::unique_ptr<WorkerQueue>> m_Queues;
+
+		/* Amount of jobs that were submitted and not taken yet */
+		std::atomic<size_t> m_PendingJobs = 0;
+
+		/* Queue that receives the next job submitted from outside of the pool */
+		std::atomic<size_t> m_NextQueue = 0;
+
+		/* Mutex & Lock for sleeping workers */
+		std::mutex m_SleepLock;
+
+		/* Wakes up the workers when a job was submitted or the pool stops */
+		std::condition_variable m_SleepCondition;
+
+		/* If the workers should exit */
+		bool m_Stopping = false;
+
+		/* The pool the current thread works for */
+		static inline thread_local ThreadPool* s_CurrentPool = nullptr;
+
+		/* The queue of the current thread if it is a worker */
+		static inline thread_local size_t s_CurrentQueue = 0;
+
+	public:
+		/**
+		 * @brief Starting the worker threads
+		 *
+		 * @param threadCount The amount of worker threads
+		 */
+		explicit ThreadPool(size_t threadCount = std::max(1u, std::thread::hardware_concurrency()))
+		{
+			threadCount = std::max<size_t>(1, threadCount);
+			for (size_t index = 0; index < threadCount; index++)
+				m_Queues.push_back(std::make_unique<WorkerQueue>());
+
+			for (size_t index = 0; index < threadCount; index++)
+				m_Workers.emplace_back([this, index]()
+				{
+					s_CurrentPool = this;
+					s_CurrentQueue = index;
+
+					std::function<void()> job;
+					while (true)
+					{
+						if (TakeJob(job))
+						{
+							job();
+							continue;
+						}
+
+						std::unique_lock<std::mutex> sleepLock(m_SleepLock);
+						m_SleepCondition.wait(sleepLock, [this]() { return m_Stopping || m_PendingJobs.load() != 0; });
+						if (m_Stopping && m_PendingJobs.load() == 0)
+							return;
+					}
+				});
+		}
+
+		~ThreadPool()
+		{
+			{
+				std::unique_lock<std::mutex> sleepLock(m_SleepLock);
+				m_Stopping = true;
+			}
+			m_SleepCondition.notify_all();
+
+			for (std::thread& worker : m_Workers)
+				worker.join();
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/**
+		 * @brief Submitting a job, workers push onto their own queue and other threads spread the jobs over all queues
+		 *
+		 * @param job The job that is getting executed
+		 */
+		void Submit(std::function<void()> job)
+		{
+			size_t queue = s_CurrentPool == this ? s_CurrentQueue : m_NextQueue.fetch_add(1, std::memory_order_relaxed) % m_Queues.size();
+			{
+				std::unique_lock<std::mutex> jobLock(m_Queues[queue]->JobLock);
+				m_Queues[queue]->Jobs.push_back(std::move(job));
+			}
+
+			m_PendingJobs.fetch_add(1);
+			{
+				std::unique_lock<std::mutex> sleepLock(m_SleepLock);
+			}
+			m_SleepCondition.notify_one();
+		}
+
+		/**
+		 * @brief Executing a waiting job on the calling thread
+		 *
+		 * @return Returns if a job was executed
+		 */
+		bool RunPendingJob()
+		{
+			std::function<void()> job;
+			if (!TakeJob(job))
+				return false;
+
+			job();
+			return true;
+		}
+
+		/**
+		 * @brief Splitting a range into chunks and executing them on the workers and the calling thread
+		 *
+		 * Returns when every chunk is done. While waiting the calling thread executes other jobs, so this can be called from a job.
+		 *
+		 * @tparam Function The type of the function, invocable with the begin and end of a chunk
+		 * @param count The size of the range
+		 * @param chunkSize The size of a chunk
+		 * @param function Function that is getting called for every chunk
+		 */
+		template<class Function>
+		void ParallelFor(size_t count, size_t chunkSize, Function&& function)
+		{
+			chunkSize = std::max<size_t>(1, chunkSize);
+			size_t chunks = (count + chunkSize - 1) / chunkSize;
+			if (chunks <= 1)
+			{
+				if (count != 0)
+					function(size_t(0), count);
+				return;
+			}
+
+			std::atomic<size_t> remaining = chunks - 1;
+			for (size_t chunk = 1; chunk < chunks; chunk++)
+				Submit([&, chunk]()
+				{
+					function(chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+					remaining.fetch_sub(1, std::memory_order_release);
+				});
+
+			function(size_t(0), chunkSize);
+			Wait(remaining);
+		}
+
+		/**
+		 * @brief Executing waiting jobs on the calling thread until a counter reaches zero
+		 *
+		 * @param remaining The counter that is decremented by the jobs that are waited for
+		 */
+		void Wait(const std::atomic<size_t>& remaining)
+		{
+			while (remaining.load(std::memory_order_acquire) != 0)
+				if (!RunPendingJob())
+					std::this_thread::yield();
+		}
+
+		/**
+		 * @brief Getting the amount of worker threads
+		 *
+		 * @return Returns the amount of worker threads
+		 */
+		size_t GetThreadCount() const
+		{
+			return m_Workers.size();
+		}
+
+		/**
+		 * @brief Getting the pool that is shared by every registry and world
+		 *
+		 * @return Returns the shared pool
+		 */
+		static ThreadPool& GetDefault()
+		{
+			static ThreadPool threadPool;
+			return threadPool;
+		}
+
+	private:
+		/**
+		 * @brief Taking a job from the own queue or stealing one from another queue
+		 *
+		 * @param job The job that was taken
+		 *
+		 * @return Returns if a job was taken
+		 */
+		bool TakeJob(std::function<void()>& job)
+		{
+			if (m_PendingJobs.load(std::memory_order_relaxed) == 0)
+				return false;
+
+			bool isWorker = s_CurrentPool == this;
+			size_t first = isWorker ? s_CurrentQueue : m_NextQueue.load(std::memory_order_relaxed);
+			for (size_t offset = 0; offset < m_Queues.size(); offset++)
+			{
+				WorkerQueue& queue = *m_Queues[(first + offset) % m_Queues.size()];
+				std::unique_lock<std::mutex> jobLock(queue.JobLock);
+				if (queue.Jobs.empty())
+					continue;
+
+				if (isWorker && offset == 0)
+				{
+					job = std::move(queue.Jobs.back());
+					queue.Jobs.pop_back();
+				}
+				else
+				{
+					job = std::move(queue.Jobs.front());
+					queue.Jobs.pop_front();
+				}
+
+				m_PendingJobs.fetch_sub(1);
+				return true;
+			}
+			return false;
+		}
+	};
+
+	/* Phase of the frame a system runs in */
+	enum class SystemPhase
+	{
+		Tick,
+		Update,
+		Render
+	};
+
+#ifdef HYPERECS_PROFILE
+	/* Timings of one phase of a system, keeps the latest samples for percentiles */
+	class SystemProfile
+	{
+	public:
+		/* Amount of the latest samples that are kept */
+		static constexpr size_t SampleCount = 128;
+
+	private:
+		/* The name of the system */
+		std::string_view m_Name;
+
+		/* Amount of calls so far */
+		uint64_t m_CallCount = 0;
+
+		/* Amount of entities the last call iterated */
+		uint64_t m_EntityCount = 0;
+
+		/* Holds the durations of the latest calls in milliseconds, oldest sample is overwritten first */
+		double m_Samples[SampleCount] = {};
+
+		/* Counter of the entities the system running on the current thread iterated */
+		static inline thread_local uint64_t* s_EntityCounter = nullptr;
+
+	public:
+		/**
+		 * @brief Setting the name of the system
+		 *
+		 * @param name The name of the system
+		 */
+		void SetName(std::string_view name)
+		{
+			m_Name = name;
+		}
+
+		/**
+		 * @brief Getting the name of the system
+		 *
+		 * @return Returns the name of the system
+		 */
+		std::string_view GetName() const
+		{
+			return m_Name;
+		}
+
+		/**
+		 * @brief Recording a call
+		 *
+		 * @param milliseconds The duration of the call
+		 * @param entityCount The amount of entities the call iterated
+		 */
+		void Record(double milliseconds, uint64_t entityCount)
+		{
+			m_Samples[m_CallCount % SampleCount] = milliseconds;
+			m_EntityCount = entityCount;
+			m_CallCount++;
+		}
+
+		/**
+		 * @brief Getting the amount of calls so far
+		 *
+		 * @return Returns the amount of calls
+		 */
+		uint64_t GetCallCount() const
+		{
+			return m_CallCount;
+		}
+
+		/**
+		 * @brief Getting the amount of entities the last call iterated
+		 *
+		 * @return Returns the amount of entities
+		 */
+		uint64_t GetEntityCount() const
+		{
+			return m_EntityCount;
+		}
+
+		/**
+		 * @brief Getting a percentile of the durations of the latest calls
+		 *
+		 * @param percentile The percentile between 0 and 100, 50 is the median
+		 *
+		 * @return Returns the duration in milliseconds or zero without calls
+		 */
+		double GetPercentile(double percentile) const
+		{
+			size_t count = static_cast<size_t>(std::min<uint64_t>(m_CallCount, SampleCount));
+			if (count == 0)
+				return 0.0;
+
+			double samples[SampleCount];
+			std::copy_n(m_Samples, count, samples);
+			size_t rank = std::min(count - 1, static_cast<size_t>(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(count)));
+			std::nth_element(samples, samples + rank, samples + count);
+			return samples[rank];
+		}
+
+		/**
+		 * @brief Adding iterated entities to the system running on the current thread, called by the registry
+		 *
+		 * @param count The amount of entities
+		 */
+		static void CountEntities(size_t count)
+		{
+			if (s_EntityCounter != nullptr)
+				*s_EntityCounter += count;
+		}
+
+		/**
+		 * @brief Setting the counter the entities iterated on the current thread are added to
+		 *
+		 * @param counter The counter or nullptr to stop counting
+		 *
+		 * @return Returns the previous counter
+		 */
+		static uint64_t* SetEntityCounter(uint64_t* counter)
+		{
+			return std::exchange(s_EntityCounter, counter);
+		}
+	};
+#endif /* HYPERECS_PROFILE */
+
+	/* Memory held by the entities and component pools of a registry */
+	struct MemoryUsage
+	{
+		/* Amount of alive entities */
+		size_t EntityCount = 0;
+
+		/* Amount of destroyed entities whose indices wait on the free list to be recycled */
+		size_t FreeEntityCount = 0;
+
+		/* Bytes of the entity array, including free and reserved indices */
+		size_t EntityBytes = 0;
+
+		/* Bytes of the entity array taken by indices on the free list */
+		size_t FreeEntityBytes = 0;
+
+		/* Bytes of the entity array per alive entity */
+		double EntityOverhead = 0.0;
+
+		/* Bytes of the ticks every entity index was last created, destroyed or changed in */
+		size_t EntityTickBytes = 0;
+
+		/* Bytes of the entities and pools of every group */
+		size_t GroupBytes = 0;
+
+		/* Bytes of the parent and child relations and their sorted order */
+		size_t HierarchyBytes = 0;
+
+		/* Holds the memory of every component pool */
+		std::vector<ComponentMemory> Components;
+
+		/* Bytes of the entity array, the entity ticks, every component pool, every group and the hierarchy */
+		size_t TotalBytes = 0;
+
+		/* Total bytes per alive entity */
+		double BytesPerEntity = 0.0;
+	};
+
+	class Registry
+	{
+	private:
+		/* Identifies the start of a snapshot */
+		static constexpr uint32_t SnapshotMagic = 0x53434548;
+
+		/* Version of the snapshot layout, bumped whenever it changes */
+		static constexpr uint32_t SnapshotVersion = 2;
+
+		/* Identifies the start of a delta */
+		static constexpr uint32_t DeltaMagic = 0x44434548;
+
+		/* Amount of pool pointers in one page of the pool table */
+		static constexpr size_t PoolPageSize = 64;
+
+		/* Amount of pages of the pool table, limits the amount of component classes */
+		static constexpr size_t PoolPageCount = 256;
+
+		/* Component class that was registered in any registry */
+		struct RegisteredComponent
+		{
+			/* The type id of the class */
+			size_t ComponentId;
+
+			/* Empty pool of the class that creates the pools of the registries */
+			std::unique_ptr<ComponentPoolBase> Prototype;
+		};
+
+		/* Holds the component classes registered in any registry, shared by every registry so every world can load them */
+		static inline std::vector<RegisteredComponent> s_RegisteredComponents;
+
+		/* Mutex & Lock for the registered component classes, taken even without HYPERECS_MUTEX since they are shared by every registry */
+		static inline std::mutex s_RegisteredComponentLock;
+
+		/* Holds the pool of every component class at the type id of the class, nullptr for classes without a pool */
+		std::vector<std::unique_ptr<ComponentPoolBase>> m_Components;
+
+		/* Holds the pages of the pools of m_Components, pages and pools never move or die before the registry so lookups need no lock */
+		std::array<std::atomic<std::atomic<ComponentPoolBase*>*>, PoolPageCount> m_PoolTable = {};
+
+		/* Holds the memory of the pages of m_PoolTable */
+		std::vector<std::unique_ptr<std::atomic<ComponentPoolBase*>[]>> m_PoolPages;
+
+		/* Holds the group of every component signature at the type id of the signature, nullptr for signatures without a group */
+		std::vector<std::unique_ptr<Group>> m_Groups;
+
+		/* Holds the entities */
+		EntityPool m_Entities;
+
+		/* Holds for every entity index the tick it was last created, destroyed or lost a component or parent in */
+		std::vector<uint64_t> m_EntityTicks;
+
+		/* The current tick, components record the tick they were added and changed in */
+		std::atomic<uint64_t> m_Tick = 0;
+
+		/* Holds the parent and child relations of the entities */
+		Hierarchy m_Hierarchy;
+
+		/* Holds the resource of every resource class at the type id of the class, nullptr for classes without a resource */
+		std::vector<std::unique_ptr<ResourceBase>> m_Resources;
+
+	#ifdef HYPERECS_MUTEX
+		/* Mutex & Lock that serializes structural changes, adding and removing components and destroying entities */
+		std::mutex m_StructureLock;
+
+		/* Mutex & Lock for the entities, shared by readers */
+		mutable std::shared_mutex m_EntityLock;
+
+		/* Mutex & Lock for the pool and group maps, shared by walks over every pool and by group lookups */
+		std::shared_mutex m_ComponentLock;
+
+		/* Mutex & Lock for the resources, shared by lookups */
+		std::shared_mutex m_ResourceLock;
+	#endif /* HYPERECS_MUTEX */
+
+	public:
+		/**
+		 * @brief Constructing an entity in the registry
+		 *
+		 * @return Returns an entity
+		 */
+		Entity Construct()
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::shared_mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			Entity entity = m_Entities.Create();
+			MarkEntity(entity);
+			return entity;
+		}
+
+		/**
+		 * @brief Constructing multiple entities in the registry at once
+		 *
+		 * @tparam OutputIt The type of the iterator the entities are written to
+		 * @param count The amount of entities that are getting constructed
+		 * @param output The iterator the entities are written to
+		 *
+		 * @return Returns the iterator past the last written entity
+		 */
+		template<class OutputIt>
+		OutputIt Construct(size_t count, OutputIt output)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::shared_mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			m_Entities.Reserve(count);
+			for (size_t index = 0; index < count; index++)
+			{
+				Entity entity = m_Entities.Create();
+				MarkEntity(entity);
+				*output++ = entity;
+			}
+			return output;
+		}
+
+		/**
+		 * @brief Destroying an entity and its components in the registry
+		 *
+		 * @param entity Entity that is getting destroyed
+		 */
+		void Destroy(Entity entity)
+		{
+			Destroy(std::span<const Entity>(&entity, 1));
+		}
+
+		/**
+		 * @brief Destroying multiple entities and their components in the registry at once
+		 *
+		 * Every pool is walked once for all entities instead of once per entity.
+		 *
+		 * @param entities The entities that are getting destroyed, each at most once
+		 */
+		void Destroy(std::span<const Entity> entities)
+		{
+			std::vector<std::pair<ComponentPoolBase*, Entity>> removed;
+			{
+			#ifdef HYPERECS_MUTEX
+				std::unique_lock<std::mutex> structureLock(m_StructureLock);
+				std::unique_lock<std::shared_mutex> entityLock(m_EntityLock);
+				std::shared_lock<std::shared_mutex> componentLock(m_ComponentLock);
+			#endif /* HYPERECS_MUTEX */
+
+				for (Entity entity : entities)
+					if (!m_Entities.IsValid(entity))
+					{
+						std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
+						__debugbreak();
+					}
+				CheckDuplicates(entities);
+
+				for (std::unique_ptr<ComponentPoolBase>& pool : m_Components)
+				{
+					if (!pool)
+						continue;
+
+				#ifdef HYPERECS_MUTEX
+					std::unique_lock<std::shared_mutex> poolLock(pool->GetLock());
+				#endif /* HYPERECS_MUTEX */
+
+					bool isObserved = !pool->GetObservers(ComponentEvent::Removed).empty();
+					for (Entity entity : entities)
+						if (pool->Contains(entity))
+						{
+							RemoveFromPool(*pool, entity);
+							if (isObserved)
+								removed.emplace_back(pool.get(), entity);
+						}
+				}
+
+				if (removed.empty())
+				{
+					ReleaseEntities(entities, false);
+					return;
+				}
+			}
+
+			for (const std::pair<ComponentPoolBase*, Entity>& component : removed)
+				Notify(*component.first, ComponentEvent::Removed, component.second);
+
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+			std::unique_lock<std::shared_mutex> entityLock(m_EntityLock);
+			std::shared_lock<std::shared_mutex> componentLock(m_ComponentLock);
+		#endif /* HYPERECS_MUTEX */
+
+			ReleaseEntities(entities, true);
+		}
+
+		/**
+		 * @brief Check if an entity is alive, stale handles of destroyed entities are not
+		 *
+		 * @param entity The entity that is getting checked
+		 *
+		 * @return Returns if the entity was alive
+		 */
+		bool IsValid(Entity entity)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::shared_lock<std::shared_mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			return m_Entities.IsValid(entity);
+		}
+
+		/**
+		 * @brief Adding component to an entity
+		 *
+		 * The returned reference stays valid until the next component of the same type is added or removed.
+		 *
+		 * @tparam T The component class that is getting created
+		 * @tparam Args The arguments for the class
+		 * @param entity The corresponding entity that the component getting assigned to
+		 * @param args The arguments for the class
+		 *
+		 * @return Returns the created component
+		 */
+		template<class T, typename... Args>
+		constexpr ComponentReference<T> AddComponent(Entity entity, Args&&... args)
+		{
+			ComponentPool<T>* pool = nullptr;
+			ComponentReference<T> component = [&]() -> ComponentReference<T>
+			{
+			#ifdef HYPERECS_MUTEX
+				std::unique_lock<std::mutex> structureLock(m_StructureLock);
+				std::shared_lock<std::shared_mutex> entityLock(m_EntityLock);
+			#endif /* HYPERECS_MUTEX */
+
+				if (!m_Entities.IsValid(entity))
+				{
+					std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
+					__debugbreak();
+				}
+
+				pool = &AssureComponentPool<T>();
+
+			#ifdef HYPERECS_MUTEX
+				std::unique_lock<std::shared_mutex> poolLock(pool->GetLock());
+			#endif /* HYPERECS_MUTEX */
+
+				if (pool->Contains(entity))
+				{
+					std::cerr << "[HyperECS] Entity already has the component!" << std::endl;
+					__debugbreak();
+				}
+
+				pool->Emplace(entity, m_Tick.load(std::memory_order_relaxed), std::forward<Args>(args)...);
+				for (Group* group : pool->GetGroups())
+					group->OnComponentAdded(entity);
+
+				/* The slot is resolved while the pool is locked, other threads may grow it or swap remove from it afterwards */
+				return pool->GetAt(pool->GetSlot(entity));
+			}();
+
+			Notify(*pool, ComponentEvent::Added, entity);
+			return component;
+		}
+
+		/**
+		 * @brief Adding a copy of a component to multiple entities at once
+		 *
+		 * The pool is grown once and the copies are appended back to back.
+		 *
+		 * @tparam T The component class that is getting created
+		 * @param entities The entities that the components getting assigned to, each at most once
+		 * @param component The component that is getting copied
+		 */
+		template<class T>
+		void AddComponents(std::span<const Entity> entities, const T& component)
+		{
+			EmplaceComponents<T>(entities, [&](size_t) -> const T& { return component; });
+		}
+
+		/**
+		 * @brief Moving components into multiple entities at once
+		 *
+		 * The pool is grown once and the components are appended back to back.
+		 *
+		 * @tparam T The component class that is getting created
+		 * @param entities The entities that the components getting assigned to, each at most once
+		 * @param components The components that are moved, one for every entity
+		 */
+		template<class T>
+		void AddComponents(std::span<const Entity> entities, std::span<T> components)
+		{
+			if (components.size() != entities.size())
+			{
+				std::cerr << "[HyperECS] Amount of components does not match the amount of entities!" << std::endl;
+				__debugbreak();
+			}
+
+			EmplaceComponents<T>(entities, [&](size_t index) -> T&& { return std::move(components[index]); });
+		}
+
+		/**
+		 * @brief Removing component from an entity
+		 *
+		 * @tparam T The component class that is getting removed
+		 * @param entity The corresponding entity where component getting removed
+		 */
+		template<class T>
+		constexpr void RemoveComponent(Entity entity)
+		{
+			ComponentPool<T>* pool = nullptr;
+			{
+			#ifdef HYPERECS_MUTEX
+				std::unique_lock<std::mutex> structureLock(m_StructureLock);
+				std::shared_lock<std::shared_mutex> entityLock(m_EntityLock);
+			#endif /* HYPERECS_MUTEX */
+
+				if (!m_Entities.IsValid(entity))
+				{
+					std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
+					__debugbreak();
+				}
+
+				pool = GetComponentPool<T>();
+				if (pool == nullptr)
+				{
+					std::cerr << "[HyperECS] Entity has not the component!" << std::endl;
+					__debugbreak();
+				}
+
+			#ifdef HYPERECS_MUTEX
+				std::unique_lock<std::shared_mutex> poolLock(pool->GetLock());
+			#endif /* HYPERECS_MUTEX */
+
+				if (!pool->Contains(entity))
+				{
+					std::cerr << "[HyperECS] Entity has not the component!" << std::endl;
+					__debugbreak();
+				}
+
+				RemoveFromPool(*pool, entity);
+			}
+
+			Notify(*pool, ComponentEvent::Removed, entity);
+		}
+
+		/**
+		 * @brief Removing multiple components from an entity
+		 *
+		 * @tparam T The component classes that are getting removed
+		 * @param entity The corresponding entity where component getting removed
+		 */
+		template<class... T>
+		constexpr void RemoveMultipleComponent(Entity entity)
+		{
+			if (!HasMultipleComponent<T...>(entity))
+			{
+				std::cerr << "[HyperECS] Entity has not the component!" << std::endl;
+				__debugbreak();
+			}
+
+			(RemoveComponent<T>(entity), ...);
+		}
+
+		/**
+		 * @brief Getting component from an entity
+		 *
+		 * With HYPERECS_MUTEX only the pool of the component is locked, and only shared, so lookups of any
+		 * component run concurrently. The entity is only checked if the lookup fails. The returned reference
+		 * stays valid until a component of the same type is added or removed.
+		 *
+		 * @tparam T The component class that is searched for
+		 * @param entity The corresponding entity that the component is assigned to
+		 *
+		 * @return Returns the corresponding component
+		 */
+		template<class T>
+		constexpr ComponentReference<T> GetComponent(Entity entity)
+		{
+			ComponentPool<T>* pool = GetComponentPool<T>();
+			if (pool != nullptr)
+			{
+			#ifdef HYPERECS_MUTEX
+				std::shared_lock<std::shared_mutex> poolLock(pool->GetLock());
+			#endif /* HYPERECS_MUTEX */
+
+				size_t slot = pool->GetSlot(entity);
+				if (slot != SparseSet::Null)
+					return pool->GetAt(slot);
+			}
+
+			ReportMissingComponent(entity);
+		}
+
+		/**
+		 * @brief Getting component from an entity for writing, marking it as changed in the current tick
+		 *
+		 * Writes through GetComponent, Each or views are not tracked, systems that want their changes to be
+		 * seen by EachChanged and the changed observers have to write through this. With HYPERECS_MUTEX the pool
+		 * is locked exclusively while the tick is written.
+		 *
+		 * @tparam T The component class that is searched for
+		 * @param entity The corresponding entity that the component is assigned to
+		 *
+		 * @return Returns the corresponding component
+		 */
+		template<class T>
+		ComponentReference<T> PatchComponent(Entity entity)
+		{
+			ComponentPool<T>* pool = GetComponentPool<T>();
+			ComponentReference<T> component = [&]() -> ComponentReference<T>
+			{
+				if (pool != nullptr)
+				{
+				#ifdef HYPERECS_MUTEX
+					std::unique_lock<std::shared_mutex> poolLock(pool->GetLock());
+				#endif /* HYPERECS_MUTEX */
+
+					size_t slot = pool->GetSlot(entity);
+					if (slot != SparseSet::Null)
+					{
+						pool->SetChangedTick(slot, m_Tick.load(std::memory_order_relaxed));
+						return pool->GetAt(slot);
+					}
+				}
+
+				ReportMissingComponent(entity);
+			}();
+
+			Notify(*pool, ComponentEvent::Changed, entity);
+			return component;
+		}
+
+		/**
+		 * @brief Check if an entity has a component
+		 *
+		 * @tparam T The component class that is getting checked
+		 * @param entity The corresponding entity that the component is assigned to
+		 *
+		 * @return Returns if the component was found
+		 */
+		template<class T>
+		constexpr bool HasComponent(Entity entity)
+		{
+			ComponentPool<T>* pool = GetComponentPool<T>();
+			if (pool != nullptr)
+			{
+			#ifdef HYPERECS_MUTEX
+				std::shared_lock<std::shared_mutex> poolLock(pool->GetLock());
+			#endif /* HYPERECS_MUTEX */
+
+				if (pool->Contains(entity))
+					return true;
+			}
+
+			/* Pools compare the whole handle, so only entities without the component can be stale */
+			if (!IsValid(entity))
+			{
+				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
+				__debugbreak();
+			}
+
+			return false;
+		}
+
+		/**
+		 * @brief Check if an entity has multiple components
+		 *
+		 * @tparam T The component classes that are getting checked
+		 * @param entity The corresponding entity that the component is assigned to
+		 *
+		 * @return Returns if the components were found
+		 */
+		template<class... T>
+		constexpr bool HasMultipleComponent(Entity entity)
+		{
+			return (HasComponent<T>(entity) && ...);
+		}
+
+		/**
+		 * @brief Registering an observer that is called after a component of a class was added, patched or removed
+		 *
+		 * Observers run on the thread that made the change after the registry released its locks, so they may
+		 * change the registry themselves. Observers have to be registered before the registry is shared between threads.
+		 * The entity is always alive while its observers run. Removed observers of Destroy, Migrate and Merge run
+		 * after every component of the entity was removed but before the entity is released, components they add
+		 * to it are removed again without notifying.
+		 *
+		 * @tparam T The component class that is observed
+		 * @param event The event that is observed
+		 * @param observer Function that is getting called with the registry and the entity after the event
+		 */
+		template<class T>
+		void Observe(ComponentEvent event, std::function<void(Registry&, Entity)> observer)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+		#endif /* HYPERECS_MUTEX */
+
+			AssureComponentPool<T>().AddObserver(event, std::move(observer));
+		}
+
+		/**
+		 * @brief Getting the current tick
+		 *
+		 * @return Returns the current tick
+		 */
+		uint64_t GetTick() const
+		{
+			return m_Tick.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Advancing to the next tick, components added or patched from now on record the new tick
+		 *
+		 * @return Returns the new tick
+		 */
+		uint64_t AdvanceTick()
+		{
+			return m_Tick.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+
+		/**
+		 * @brief Calling a function for every component of a class that was added in or after a tick
+		 *
+		 * With HYPERECS_MUTEX the pool is locked for reading while iterating, the function must not add, patch or remove components of the class.
+		 *
+		 * @tparam T The class that is getting filtered
+		 * @tparam Function The type of the function, invocable with an entity and a reference to the component
+		 * @param sinceTick The first tick that is taken into account
+		 * @param function Function that is getting called for every entity whose component was added since the tick
+		 */
+		template<class T, class Function>
+		void EachAdded(uint64_t sinceTick, Function&& function)
+		{
+			ComponentPool<T>* pool = GetComponentPool<T>();
+			if (pool == nullptr)
+				return;
+
+		#ifdef HYPERECS_MUTEX
+			std::shared_lock<std::shared_mutex> poolLock(pool->GetLock());
+		#endif /* HYPERECS_MUTEX */
+
+			const std::vector<Entity>& entities = pool->GetEntities();
+			for (size_t index = entities.size(); index-- > 0;)
+				if (pool->GetAddedTick(index) >= sinceTick)
+					function(entities[index], pool->GetAt(index));
+		}
+
+		/**
+		 * @brief Calling a function for every component of a class that was added or patched in or after a tick
+		 *
+		 * A system that remembers the tick of its last run only visits the components that changed since then.
+		 * With HYPERECS_MUTEX the pool is locked for reading while iterating, the function must not add, patch or remove components of the class.
+		 *
+		 * @tparam T The class that is getting filtered
+		 * @tparam Function The type of the function, invocable with an entity and a reference to the component
+		 * @param sinceTick The first tick that is taken into account
+		 * @param function Function that is getting called for every entity whose component changed since the tick
+		 */
+		template<class T, class Function>
+		void EachChanged(uint64_t sinceTick, Function&& function)
+		{
+			ComponentPool<T>* pool = GetComponentPool<T>();
+			if (pool == nullptr)
+				return;
+
+		#ifdef HYPERECS_MUTEX
+			std::shared_lock<std::shared_mutex> poolLock(pool->GetLock());
+		#endif /* HYPERECS_MUTEX */
+
+			const std::vector<Entity>& entities = pool->GetEntities();
+			for (size_t index = entities.size(); index-- > 0;)
+				if (pool->GetChangedTick(index) >= sinceTick)
+					function(entities[index], pool->GetAt(index));
+		}
+
+		/**
+		 * @brief Recording the removed components of a class, so EachRemoved can visit them
+		 *
+		 * The removals are kept until TrimRemoved forgets them. Like observers, tracking has to be enabled
+		 * before the registry is shared between threads.
+		 *
+		 * @tparam T The class whose removals are recorded
+		 */
+		template<class T>
+		void TrackRemoved()
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+		#endif /* HYPERECS_MUTEX */
+
+			AssureComponentPool<T>().TrackRemoved();
+		}
+
+		/**
+		 * @brief Calling a function for every component of a class that was removed in or after a tick
+		 *
+		 * Removals are only recorded after TrackRemoved. The entity is passed as it was when the component was
+		 * removed, it may be destroyed since and may have the component again.
+		 *
+		 * @tparam T The class that is getting filtered
+		 * @tparam Function The type of the function, invocable with an entity
+		 * @param sinceTick The first tick that is taken into account
+		 * @param function Function that is getting called for every entity whose component was removed since the tick
+		 */
+		template<class T, class Function>
+		void EachRemoved(uint64_t sinceTick, Function&& function)
+		{
+			ComponentPool<T>* pool = GetComponentPool<T>();
+			if (pool == nullptr || !pool->IsRemovedTracked())
+			{
+				std::cerr << "[HyperECS] Removals of the component are not tracked!" << std::endl;
+				__debugbreak();
+			}
+
+		#ifdef HYPERECS_MUTEX
+			std::shared_lock<std::shared_mutex> poolLock(pool->GetLock());
+		#endif /* HYPERECS_MUTEX */
+
+			const std::vector<std::pair<uint64_t, Entity>>& removed = pool->GetRemoved();
+			auto begin = std::partition_point(removed.begin(), removed.end(), [sinceTick](const std::pair<uint64_t, Entity>& component) { return component.first < sinceTick; });
+			for (auto iterator = begin; iterator != removed.end(); iterator++)
+				function(iterator->second);
+		}
+
+		/**
+		 * @brief Forgetting the recorded removals of a class before a tick
+		 *
+		 * Trim to the oldest tick any reader of EachRemoved still passes, otherwise the recorded removals keep growing.
+		 *
+		 * @tparam T The class whose removals are forgotten
+		 * @param beforeTick The first tick whose removals are kept
+		 */
+		template<class T>
+		void TrimRemoved(uint64_t beforeTick)
+		{
+			ComponentPool<T>* pool = GetComponentPool<T>();
+			if (pool == nullptr)
+				return;
+
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::shared_mutex> poolLock(pool->GetLock());
+		#endif /* HYPERECS_MUTEX */
+
+			pool->TrimRemoved(beforeTick);
+		}
+
+		/**
+		 * @brief Calling a function for every entity
+		 *
+		 * @tparam Function The type of the function, invocable with an entity
+		 * @param function Function that is getting called for every entity
+		 */
+		template<class Function>
+		void Each(Function&& function)
+		{
+		#ifdef HYPERECS_PROFILE
+			SystemProfile::CountEntities(m_Entities.Size());
+		#endif /* HYPERECS_PROFILE */
+
+			m_Entities.Each(function);
+		}
+
+		/**
+		 * @brief Calling a function for every entity with specified components
+		 *
+		 * A single component walks its pool, multiple components walk the group of the signature.
+		 * Removing the component of the current entity inside the function is allowed. Iterating takes no lock,
+		 * with HYPERECS_MUTEX other threads must not change the iterated pools at the same time.
+		 *
+		 * @tparam T The classes that are getting filtered
+		 * @tparam Function The type of the function, invocable with an entity and references to the components
+		 * @param function Function that is getting called for every entity that has the specified components
+		 */
+		template<class... T, class Function> requires (sizeof...(T) > 0)
+		constexpr void Each(Function&& function)
+		{
+			if constexpr (sizeof...(T) == 1)
+			{
+				ComponentPool<T...>* pool = GetComponentPool<T...>();
+				if (pool == nullptr)
+					return;
+
+				const std::vector<Entity>& entities = pool->GetEntities();
+
+			#ifdef HYPERECS_PROFILE
+				SystemProfile::CountEntities(entities.size());
+			#endif /* HYPERECS_PROFILE */
+
+				for (size_t index = entities.size(); index-- > 0;)
+					function(entities[index], pool->GetAt(index));
+			}
+			else
+			{
+				const std::vector<Entity>& entities = GetGroup<T...>().GetEntities();
+				std::tuple<ComponentPool<T>*...> pools = { GetComponentPool<T>()... };
+
+			#ifdef HYPERECS_PROFILE
+				SystemProfile::CountEntities(entities.size());
+			#endif /* HYPERECS_PROFILE */
+
+				for (size_t index = entities.size(); index-- > 0;)
+					function(entities[index], std::get<ComponentPool<T>*>(pools)->Get(entities[index])...);
+			}
+		}
+
+		/**
+		 * @brief Getting all entities
+		 *
+		 * @return Returns all entities
+		 */
+		std::vector<Entity> GetEntities() const
+		{
+		#ifdef HYPERECS_MUTEX
+			std::shared_lock<std::shared_mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			return m_Entities.GetEntities();
+		}
+
+		/**
+		 * @brief Getting all entities with specified components
+		 *
+		 * @tparam T The classes that are getting filtered
+		 *
+		 * @return Returns all entities with specified components
+		 */
+		template<class... T> requires (sizeof...(T) > 0)
+		constexpr std::vector<Entity> GetEntities()
+		{
+			if constexpr (sizeof...(T) == 1)
+			{
+				ComponentPool<T...>* pool = GetComponentPool<T...>();
+				if (pool == nullptr)
+					return std::vector<Entity>();
+
+			#ifdef HYPERECS_MUTEX
+				std::shared_lock<std::shared_mutex> poolLock(pool->GetLock());
+			#endif /* HYPERECS_MUTEX */
+
+				return pool->GetEntities();
+			}
+			else
+			{
+				Group& group = GetGroup<T...>();
+
+			#ifdef HYPERECS_MUTEX
+				std::unique_lock<std::mutex> structureLock(m_StructureLock);
+			#endif /* HYPERECS_MUTEX */
+
+				return group.GetEntities();
+			}
+		}
+
+		/**
+		 * @brief Calling a function for every entity with specified components from multiple threads
+		 *
+		 * The matching entities are split into chunks that run on the shared thread pool, the call returns when all are done.
+		 * Inside the function it is safe to read and write the passed components and to read other components that no
+		 * concurrent call writes. Constructing or destroying entities and adding or removing components is not allowed.
+		 *
+		 * @tparam T The classes that are getting filtered
+		 * @tparam Function The type of the function, invocable with an entity and references to the components
+		 * @param function Function that is getting called for every entity that has the specified components
+		 * @param chunkSize The amount of entities per job, chosen from the thread count if zero
+		 */
+		template<class... T, class Function> requires (sizeof...(T) > 0)
+		void ParallelEach(Function&& function, size_t chunkSize = 0)
+		{
+			ThreadPool& threadPool = ThreadPool::GetDefault();
+			ComponentView<T...> view = View<T...>();
+			if (chunkSize == 0)
+				chunkSize = std::max<size_t>(64, view.Size() / ((threadPool.GetThreadCount() + 1) * 4) + 1);
+
+			threadPool.ParallelFor(view.Size(), chunkSize, [&](size_t begin, size_t end)
+			{
+				typename ComponentView<T...>::Iterator iterator(&view, begin);
+				for (size_t index = begin; index < end; index++, ++iterator)
+					std::apply(function, *iterator);
+			});
+		}
+
+		/**
+		 * @brief Calling a function once with aligned spans over the fields of every entity with specified field components
+		 *
+		 * Multiple components are arranged first, their pools move the entities that have all of them to the front in
+		 * the same order, so the spans of every component line up with the entities. Loops over the spans run in
+		 * unit stride and can be vectorized. Writes through the spans are not tracked as changes.
+		 *
+		 * @tparam T The field component classes that are getting filtered
+		 * @tparam Function The type of the function, invocable with a span of the entities and FieldSpans of every component
+		 * @param function Function that is getting called with the spans
+		 */
+		template<class... T, class Function> requires (sizeof...(T) > 0 && (FieldComponent<T> && ...))
+		void EachFields(Function&& function)
+		{
+			using First = std::tuple_element_t<0, std::tuple<T...>>;
+
+			size_t size = 0;
+			if constexpr (sizeof...(T) == 1)
+			{
+				size = AssureComponentPool<First>().Size();
+			}
+			else
+			{
+				Group& group = GetGroup<T...>();
+
+			#ifdef HYPERECS_MUTEX
+				std::unique_lock<std::mutex> structureLock(m_StructureLock);
+			#endif /* HYPERECS_MUTEX */
+
+				const std::vector<Entity>& entities = group.GetEntities();
+				(Arrange(*GetComponentPool<T>(), entities), ...);
+				size = entities.size();
+			}
+
+		#ifdef HYPERECS_PROFILE
+			SystemProfile::CountEntities(size);
+		#endif /* HYPERECS_PROFILE */
+
+			std::span<const Entity> entities(GetComponentPool<First>()->GetEntities().data(), size);
+			function(entities, FieldSpans<T>(GetComponentPool<T>(), size)...);
+		}
+
+		/**
+		 * @brief Creating a query over the entities that match every term
+		 *
+		 * Terms are component classes that are required, Without<T> for excluded, Optional<T> for optional and
+		 * Changed<T> for required components that were added or marked as changed in sinceTick or later. The
+		 * query walks the smallest pool of the required components.
+		 *
+		 * @tparam Terms The terms of the query
+		 * @param sinceTick The tick changed terms compare against
+		 *
+		 * @return Returns the query
+		 */
+		template<class... Terms>
+		ComponentQuery<Terms...> Query(uint64_t sinceTick = 0)
+		{
+			return ComponentQuery<Terms...>({ GetComponentPool<typename QueryTerm<Terms>::Component>()... }, sinceTick);
+		}
+
+		/**
+		 * @brief Getting a range over every entity with specified components
+		 *
+		 * The range yields a tuple of the entity and references to the components, so it can be used with structured bindings.
+		 * Components must not be added or removed while the range is iterated.
+		 *
+		 * @tparam T The classes that are getting filtered
+		 *
+		 * @return Returns the range
+		 */
+		template<class... T> requires (sizeof...(T) > 0)
+		ComponentView<T...> View()
+		{
+			if constexpr (sizeof...(T) == 1)
+			{
+				ComponentPool<T...>& pool = AssureComponentPool<T...>();
+
+			#ifdef HYPERECS_PROFILE
+				SystemProfile::CountEntities(pool.Size());
+			#endif /* HYPERECS_PROFILE */
+
+				return ComponentView<T...>(pool.GetEntities(), &pool);
+			}
+			else
+			{
+				const std::vector<Entity>& entities = GetGroup<T...>().GetEntities();
+
+			#ifdef HYPERECS_PROFILE
+				SystemProfile::CountEntities(entities.size());
+			#endif /* HYPERECS_PROFILE */
+
+				return ComponentView<T...>(entities, GetComponentPool<T>()...);
+			}
+		}
+
+		/**
+		 * @brief Attaching an entity to a parent, the entity is detached from its previous parent
+		 *
+		 * @param child The entity that is getting attached
+		 * @param parent The new parent of the entity
+		 */
+		void SetParent(Entity child, Entity parent)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+			std::shared_lock<std::shared_mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			if (!m_Entities.IsValid(child) || !m_Entities.IsValid(parent))
+			{
+				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
+				__debugbreak();
+			}
+
+			if (child == parent || m_Hierarchy.IsAncestor(child, parent))
+			{
+				std::cerr << "[HyperECS] Entity can not be its own ancestor!" << std::endl;
+				__debugbreak();
+			}
+
+			m_Hierarchy.SetParent(child, parent);
+			MarkEntity(child);
+		}
+
+		/**
+		 * @brief Detaching an entity from its parent, the entity becomes a root
+		 *
+		 * @param child The entity that is getting detached
+		 */
+		void RemoveParent(Entity child)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+			std::shared_lock<std::shared_mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			m_Hierarchy.RemoveParent(child);
+			MarkEntity(child);
+		}
+
+		/**
+		 * @brief Getting the parent of an entity
+		 *
+		 * @param child The entity whose parent is searched for
+		 *
+		 * @return Returns the parent or the null entity if the entity has no parent
+		 */
+		Entity GetParent(Entity child)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+		#endif /* HYPERECS_MUTEX */
+
+			return m_Hierarchy.GetParent(child);
+		}
+
+		/**
+		 * @brief Calling a function for every child of an entity
+		 *
+		 * With HYPERECS_MUTEX the children are collected under the lock first and the function is called after it was released.
+		 *
+		 * @tparam Function The type of the function, invocable with an entity
+		 * @param parent The entity whose children are visited
+		 * @param function Function that is getting called for every child
+		 */
+		template<class Function>
+		void EachChild(Entity parent, Function&& function)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::vector<Entity> children;
+			{
+				std::unique_lock<std::mutex> structureLock(m_StructureLock);
+				m_Hierarchy.EachChild(parent, [&](Entity child) { children.push_back(child); });
+			}
+
+			for (Entity child : children)
+				function(child);
+		#else
+			m_Hierarchy.EachChild(parent, function);
+		#endif /* HYPERECS_MUTEX */
+		}
+
+		/**
+		 * @brief Getting the hierarchy sorted by depth, for traversals that keep their data in arrays parallel to the order
+		 *
+		 * The hierarchy is sorted again if relations changed. It stays valid until the next relation changes.
+		 *
+		 * @return Returns the hierarchy
+		 */
+		const Hierarchy& GetHierarchy()
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+		#endif /* HYPERECS_MUTEX */
+
+			m_Hierarchy.Sort();
+			return m_Hierarchy;
+		}
+
+		/**
+		 * @brief Calling a function for every entity with a parent or children, parents before their children
+		 *
+		 * The entities are visited breadth first out of one array sorted by depth, so propagating values from
+		 * parents to children, like world transforms, is a single linear pass. Relations must not change inside the function.
+		 *
+		 * @tparam Function The type of the function, invocable with an entity and its parent, the null entity for roots
+		 * @param function Function that is getting called for every entity in the hierarchy
+		 */
+		template<class Function>
+		void EachHierarchy(Function&& function)
+		{
+			const Hierarchy& hierarchy = GetHierarchy();
+			const std::vector<Entity>& order = hierarchy.GetOrder();
+			const std::vector<size_t>& parents = hierarchy.GetParentIndices();
+
+		#ifdef HYPERECS_PROFILE
+			SystemProfile::CountEntities(order.size());
+		#endif /* HYPERECS_PROFILE */
+
+			for (size_t index = 0; index < order.size(); index++)
+				function(order[index], parents[index] != Hierarchy::Null ? order[parents[index]] : Entity({ 0 }));
+		}
+
+		/**
+		 * @brief Calling a function for every entity with a parent or children on the shared thread pool, parents before their children
+		 *
+		 * Every depth is split into chunks that run in parallel, the next depth starts when the previous one is done.
+		 * Inside the function it is safe to read the parent and write the entity. Relations must not change inside the function.
+		 *
+		 * @tparam Function The type of the function, invocable with an entity and its parent, the null entity for roots
+		 * @param function Function that is getting called for every entity in the hierarchy
+		 * @param chunkSize The amount of entities per job, chosen from the thread count if zero
+		 */
+		template<class Function>
+		void ParallelEachHierarchy(Function&& function, size_t chunkSize = 0)
+		{
+			ThreadPool& threadPool = ThreadPool::GetDefault();
+			const Hierarchy& hierarchy = GetHierarchy();
+			const std::vector<Entity>& order = hierarchy.GetOrder();
+			const std::vector<size_t>& parents = hierarchy.GetParentIndices();
+
+		#ifdef HYPERECS_PROFILE
+			SystemProfile::CountEntities(order.size());
+		#endif /* HYPERECS_PROFILE */
+
+			for (size_t depth = 0; depth < hierarchy.GetLevelCount(); depth++)
+			{
+				std::pair<size_t, size_t> level = hierarchy.GetLevel(depth);
+				size_t size = level.second - level.first;
+				size_t levelChunkSize = chunkSize != 0 ? chunkSize : std::max<size_t>(64, size / ((threadPool.GetThreadCount() + 1) * 4) + 1);
+				threadPool.ParallelFor(size, levelChunkSize, [&](size_t begin, size_t end)
+				{
+					for (size_t index = level.first + begin; index < level.first + end; index++)
+						function(order[index], parents[index] != Hierarchy::Null ? order[parents[index]] : Entity({ 0 }));
+				});
+			}
+		}
+
+		/**
+		 * @brief Constructing the resource of a class, a previous resource of the class is replaced
+		 *
+		 * The returned reference stays valid until the resource is replaced or removed.
+		 *
+		 * @tparam T The resource class that is getting created
+		 * @tparam Args The arguments for the class
+		 * @param args The arguments for the class
+		 *
+		 * @return Returns the created resource
+		 */
+		template<class T, typename... Args>
+		T& SetResource(Args&&... args)
+		{
+			std::unique_ptr<Resource<T>> resource = std::make_unique<Resource<T>>(std::forward<Args>(args)...);
+			T& value = resource->Value;
+
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::shared_mutex> resourceLock(m_ResourceLock);
+		#endif /* HYPERECS_MUTEX */
+
+			size_t resourceId = TypeIndex<ResourceBase>::Get<T>();
+			if (resourceId >= m_Resources.size())
+				m_Resources.resize(resourceId + 1);
+			m_Resources[resourceId] = std::move(resource);
+			return value;
+		}
+
+		/**
+		 * @brief Removing the resource of a class
+		 *
+		 * @tparam T The resource class that is getting removed
+		 */
+		template<class T>
+		void RemoveResource()
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::shared_mutex> resourceLock(m_ResourceLock);
+		#endif /* HYPERECS_MUTEX */
+
+			size_t resourceId = TypeIndex<ResourceBase>::Get<T>();
+			if (resourceId >= m_Resources.size() || !m_Resources[resourceId])
+			{
+				std::cerr << "[HyperECS] Resource does not exists!" << std::endl;
+				__debugbreak();
+			}
+
+			m_Resources[resourceId].reset();
+		}
+
+		/**
+		 * @brief Getting the resource of a class, a lookup by the type id of the class without hashing
+		 *
+		 * @tparam T The resource class that is searched for
+		 *
+		 * @return Returns the resource
+		 */
+		template<class T>
+		T& GetResource()
+		{
+			T* resource = TryGetResource<T>();
+			if (resource == nullptr)
+			{
+				std::cerr << "[HyperECS] Resource does not exists!" << std::endl;
+				__debugbreak();
+			}
+
+			return *resource;
+		}
+
+		/**
+		 * @brief Getting the resource of a class if it exists
+		 *
+		 * @tparam T The resource class that is searched for
+		 *
+		 * @return Returns the resource or nullptr if the class has no resource
+		 */
+		template<class T>
+		T* TryGetResource()
+		{
+		#ifdef HYPERECS_MUTEX
+			std::shared_lock<std::shared_mutex> resourceLock(m_ResourceLock);
+		#endif /* HYPERECS_MUTEX */
+
+			size_t resourceId = TypeIndex<ResourceBase>::Get<T>();
+			if (resourceId >= m_Resources.size() || !m_Resources[resourceId])
+				return nullptr;
+			return &static_cast<Resource<T>*>(m_Resources[resourceId].get())->Value;
+		}
+
+		/**
+		 * @brief Check if a class has a resource
+		 *
+		 * @tparam T The resource class that is getting checked
+		 *
+		 * @return Returns if the resource was found
+		 */
+		template<class T>
+		bool HasResource()
+		{
+			return TryGetResource<T>() != nullptr;
+		}
+
+		/**
+		 * @brief Creating the pool of a component class up front, snapshots can only be loaded into registered classes
+		 *
+		 * The class is registered for every registry, so registering it once lets every world load it.
+		 *
+		 * @tparam T The component class of the pool
+		 */
+		template<class T>
+		void Register()
+		{
+			{
+				std::unique_lock<std::mutex> registeredComponentLock(s_RegisteredComponentLock);
+
+				size_t componentId = TypeIndex<ComponentPoolBase>::Get<T>();
+				if (std::none_of(s_RegisteredComponents.begin(), s_RegisteredComponents.end(), [componentId](const RegisteredComponent& component) { return component.ComponentId == componentId; }))
+					s_RegisteredComponents.push_back({ componentId, std::make_unique<ComponentPool<T>>() });
+			}
+
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+		#endif /* HYPERECS_MUTEX */
+
+			AssureComponentPool<T>();
+		}
+
+		/**
+		 * @brief Writing the entities, every serializable component pool and the hierarchy to a binary snapshot
+		 *
+		 * Pools of trivially copyable components are written as one block each, others through their component traits.
+		 * Pools whose components can not be serialized are skipped, resources are not part of the snapshot.
+		 *
+		 * @param stream The stream that is written to
+		 */
+		void Save(std::ostream& stream)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+			std::shared_lock<std::shared_mutex> entityLock(m_EntityLock);
+			std::shared_lock<std::shared_mutex> componentLock(m_ComponentLock);
+		#endif /* HYPERECS_MUTEX */
+
+			WriteBinary(stream, &SnapshotMagic);
+			WriteBinary(stream, &SnapshotVersion);
+			m_Entities.Save(stream);
+
+			uint64_t tick = m_Tick.load(std::memory_order_relaxed);
+			WriteBinary(stream, &tick);
+
+			uint64_t poolCount = std::count_if(m_Components.begin(), m_Components.end(), [](const std::unique_ptr<ComponentPoolBase>& pool) { return pool && pool->IsSerializable(); });
+			WriteBinary(stream, &poolCount);
+			for (std::unique_ptr<ComponentPoolBase>& pool : m_Components)
+			{
+				if (!pool || !pool->IsSerializable())
+					continue;
+
+			#ifdef HYPERECS_MUTEX
+				std::shared_lock<std::shared_mutex> poolLock(pool->GetLock());
+			#endif /* HYPERECS_MUTEX */
+
+				uint64_t typeHash = pool->GetTypeHash();
+				WriteBinary(stream, &typeHash);
+				pool->Save(stream);
+			}
+
+			std::vector<Entity> relations;
+			for (Entity entity : m_Hierarchy.GetEntities())
+				if (m_Hierarchy.GetParent(entity).IsHandleValid())
+				{
+					relations.push_back(entity);
+					relations.push_back(m_Hierarchy.GetParent(entity));
+				}
+
+			uint64_t relationCount = relations.size() / 2;
+			WriteBinary(stream, &relationCount);
+			WriteBinary(stream, relations.data(), relations.size());
+		}
+
+		/**
+		 * @brief Replacing the entities, components and hierarchy with the ones of a binary snapshot
+		 *
+		 * Every component class of the snapshot has to be registered in any registry, pools that are not part of the snapshot are cleared.
+		 * Observers are not notified.
+		 *
+		 * @param stream The stream that is read from
+		 */
+		void Load(std::istream& stream)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+			std::unique_lock<std::shared_mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			AssureRegisteredComponentPools();
+
+		#ifdef HYPERECS_MUTEX
+			std::shared_lock<std::shared_mutex> componentLock(m_ComponentLock);
+		#endif /* HYPERECS_MUTEX */
+
+			uint32_t magic = 0;
+			uint32_t version = 0;
+			ReadBinary(stream, &magic);
+			ReadBinary(stream, &version);
+			if (magic != SnapshotMagic || version != SnapshotVersion)
+			{
+				std::cerr << "[HyperECS] Snapshot is not valid!" << std::endl;
+				__debugbreak();
+			}
+
+			m_Entities.Load(stream);
+
+			uint64_t tick = 0;
+			ReadBinary(stream, &tick);
+			m_Tick.store(tick, std::memory_order_relaxed);
+			m_EntityTicks.assign(m_Entities.Size(), tick);
+
+			for (std::unique_ptr<ComponentPoolBase>& pool : m_Components)
+				if (pool)
+				{
+				#ifdef HYPERECS_MUTEX
+					std::unique_lock<std::shared_mutex> poolLock(pool->GetLock());
+				#endif /* HYPERECS_MUTEX */
+
+					pool->Clear();
+				}
+
+			uint64_t poolCount = 0;
+			ReadBinary(stream, &poolCount);
+			for (uint64_t index = 0; index < poolCount; index++)
+			{
+				uint64_t typeHash = 0;
+				ReadBinary(stream, &typeHash);
+
+				auto pool = std::find_if(m_Components.begin(), m_Components.end(), [typeHash](const std::unique_ptr<ComponentPoolBase>& pool) { return pool && pool->GetTypeHash() == typeHash; });
+				if (pool == m_Components.end())
+				{
+					std::cerr << "[HyperECS] Component of the snapshot is not registered!" << std::endl;
+					__debugbreak();
+				}
+
+			#ifdef HYPERECS_MUTEX
+				std::unique_lock<std::shared_mutex> poolLock((*pool)->GetLock());
+			#endif /* HYPERECS_MUTEX */
+
+				(*pool)->Load(stream);
+			}
+
+			for (std::unique_ptr<Group>& group : m_Groups)
+				if (group)
+					group->Rebuild();
+
+			uint64_t relationCount = 0;
+			ReadBinary(stream, &relationCount);
+			std::vector<Entity> relations(relationCount * 2);
+			ReadBinary(stream, relations.data(), relations.size());
+
+			m_Hierarchy.Clear();
+			for (size_t index = 0; index < relations.size(); index += 2)
+				m_Hierarchy.SetParent(relations[index], relations[index + 1]);
+		}
+
+		/**
+		 * @brief Writing the changes made in or after a tick to a binary delta
+		 *
+		 * The delta holds the entities that were created or destroyed, the serializable components that were added or patched,
+		 * the ones that were removed and the parents that changed. A registry holding the state from before the tick, like a
+		 * snapshot or the previous delta, is brought up to date by LoadDelta. Write the previous snapshot or delta, advance the
+		 * tick and pass the new tick, so no change is missed. Components changed through GetComponent without PatchComponent
+		 * are not part of the delta.
+		 *
+		 * @param stream The stream that is written to
+		 * @param sinceTick The first tick whose changes are written
+		 */
+		void SaveDelta(std::ostream& stream, uint64_t sinceTick)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+			std::shared_lock<std::shared_mutex> entityLock(m_EntityLock);
+			std::shared_lock<std::shared_mutex> componentLock(m_ComponentLock);
+		#endif /* HYPERECS_MUTEX */
+
+			WriteBinary(stream, &DeltaMagic);
+			WriteBinary(stream, &SnapshotVersion);
+
+			uint64_t tick = m_Tick.load(std::memory_order_relaxed);
+			WriteBinary(stream, &tick);
+
+			std::vector<uint32_t> indices;
+			std::vector<Entity> changed;
+			for (uint32_t index = 0; index < m_EntityTicks.size(); index++)
+				if (m_EntityTicks[index] >= sinceTick)
+				{
+					indices.push_back(index);
+					Entity entity = m_Entities.GetEntity(index);
+					if (entity.IsHandleValid())
+						changed.push_back(entity);
+				}
+			m_Entities.SaveDelta(stream, indices);
+
+			uint64_t poolCount = std::count_if(m_Components.begin(), m_Components.end(), [](const std::unique_ptr<ComponentPoolBase>& pool) { return pool && pool->IsSerializable(); });
+			WriteBinary(stream, &poolCount);
+			for (std::unique_ptr<ComponentPoolBase>& pool : m_Components)
+			{
+				if (!pool || !pool->IsSerializable())
+					continue;
+
+			#ifdef HYPERECS_MUTEX
+				std::shared_lock<std::shared_mutex> poolLock(pool->GetLock());
+			#endif /* HYPERECS_MUTEX */
+
+				std::vector<Entity> removed;
+				for (Entity entity : changed)
+					if (!pool->Contains(entity))
+						removed.push_back(entity);
+
+				uint64_t typeHash = pool->GetTypeHash();
+				uint64_t removedCount = removed.size();
+				WriteBinary(stream, &typeHash);
+				WriteBinary(stream, &removedCount);
+				WriteBinary(stream, removed.data(), removed.size());
+				pool->SaveChanged(stream, sinceTick);
+			}
+
+			std::vector<Entity> relations;
+			for (Entity entity : changed)
+			{
+				relations.push_back(entity);
+				relations.push_back(m_Hierarchy.GetParent(entity));
+			}
+
+			uint64_t relationCount = relations.size() / 2;
+			WriteBinary(stream, &relationCount);
+			WriteBinary(stream, relations.data(), relations.size());
+		}
+
+		/**
+		 * @brief Applying a binary delta written by SaveDelta, the registry has to hold the state the delta was made against
+		 *
+		 * Every component class of the delta has to be registered in any registry. Observers are not notified.
+		 *
+		 * @param stream The stream that is read from
+		 */
+		void LoadDelta(std::istream& stream)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+			std::unique_lock<std::shared_mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			AssureRegisteredComponentPools();
+
+		#ifdef HYPERECS_MUTEX
+			std::shared_lock<std::shared_mutex> componentLock(m_ComponentLock);
+		#endif /* HYPERECS_MUTEX */
+
+			uint32_t magic = 0;
+			uint32_t version = 0;
+			ReadBinary(stream, &magic);
+			ReadBinary(stream, &version);
+			if (magic != DeltaMagic || version != SnapshotVersion)
+			{
+				std::cerr << "[HyperECS] Delta is not valid!" << std::endl;
+				__debugbreak();
+			}
+
+			uint64_t tick = 0;
+			ReadBinary(stream, &tick);
+			m_Tick.store(tick, std::memory_order_relaxed);
+
+			std::vector<Entity> released;
+			std::vector<uint32_t> indices = m_Entities.LoadDelta(stream, released);
+			for (std::unique_ptr<ComponentPoolBase>& pool : m_Components)
+			{
+				if (!pool)
+					continue;
+
+			#ifdef HYPERECS_MUTEX
+				std::unique_lock<std::shared_mutex> poolLock(pool->GetLock());
+			#endif /* HYPERECS_MUTEX */
+
+				for (Entity entity : released)
+					if (pool->Contains(entity))
+						RemoveFromPool(*pool, entity);
+			}
+
+			for (Entity entity : released)
+				m_Hierarchy.Remove(entity);
+
+			m_EntityTicks.resize(m_Entities.Size());
+			for (uint32_t index : indices)
+				m_EntityTicks[index] = tick;
+
+			uint64_t poolCount = 0;
+			ReadBinary(stream, &poolCount);
+			for (uint64_t index = 0; index < poolCount; index++)
+			{
+				uint64_t typeHash = 0;
+				ReadBinary(stream, &typeHash);
+
+				auto pool = std::find_if(m_Components.begin(), m_Components.end(), [typeHash](const std::unique_ptr<ComponentPoolBase>& pool) { return pool && pool->GetTypeHash() == typeHash; });
+				if (pool == m_Components.end())
+				{
+					std::cerr << "[HyperECS] Component of the delta is not registered!" << std::endl;
+					__debugbreak();
+				}
+
+			#ifdef HYPERECS_MUTEX
+				std::unique_lock<std::shared_mutex> poolLock((*pool)->GetLock());
+			#endif /* HYPERECS_MUTEX */
+
+				uint64_t removedCount = 0;
+				ReadBinary(stream, &removedCount);
+				std::vector<Entity> removed(removedCount);
+				ReadBinary(stream, removed.data(), removed.size());
+				for (Entity entity : removed)
+					if ((*pool)->Contains(entity))
+						RemoveFromPool(**pool, entity);
+
+				std::vector<Entity> added;
+				(*pool)->LoadChanged(stream, added);
+				for (Group* group : (*pool)->GetGroups())
+					for (Entity entity : added)
+						group->OnComponentAdded(entity);
+			}
+
+			uint64_t relationCount = 0;
+			ReadBinary(stream, &relationCount);
+			std::vector<Entity> relations(relationCount * 2);
+			ReadBinary(stream, relations.data(), relations.size());
+			for (size_t index = 0; index < relations.size(); index += 2)
+				if (m_Hierarchy.GetParent(relations[index]).IsHandleValid())
+					m_Hierarchy.RemoveParent(relations[index]);
+			for (size_t index = 0; index < relations.size(); index += 2)
+				if (relations[index + 1].IsHandleValid())
+					m_Hierarchy.SetParent(relations[index], relations[index + 1]);
+		}
+
+		/**
+		 * @brief Moving an entity and its components into another registry
+		 *
+		 * @param entity The entity that is getting moved, it is destroyed in this registry
+		 * @param destination The registry the entity is moved to
+		 *
+		 * @return Returns the entity in the destination
+		 */
+		Entity Migrate(Entity entity, Registry& destination)
+		{
+			Entity migrated = Entity({ 0 });
+			Migrate(std::span<const Entity>(&entity, 1), destination, &migrated);
+			return migrated;
+		}
+
+		/**
+		 * @brief Moving multiple entities and their components into another registry at once
+		 *
+		 * Every pool is walked once for all entities and the components are moved into the pools of the destination in bulk,
+		 * pools the destination does not have yet are created. Parent relations between the moved entities are kept, relations
+		 * to entities that stay are removed. The moved components count as added in the current tick of the destination, the
+		 * removed observers of this registry and the added observers of the destination are notified.
+		 *
+		 * @tparam OutputIt The type of the iterator the entities in the destination are written to
+		 * @param entities The entities that are getting moved, each at most once, they are destroyed in this registry
+		 * @param destination The registry the entities are moved to
+		 * @param output The iterator the entities in the destination are written to, in the order of the moved entities
+		 *
+		 * @return Returns the iterator past the last written entity
+		 */
+		template<class OutputIt>
+		OutputIt Migrate(std::span<const Entity> entities, Registry& destination, OutputIt output)
+		{
+			std::vector<Entity> migrated = MigrateEntities(entities, destination);
+			return std::copy(migrated.begin(), migrated.end(), output);
+		}
+
+		/**
+		 * @brief Moving multiple entities and their components into another registry at once, discarding their new handles
+		 *
+		 * @param entities The entities that are getting moved, each at most once, they are destroyed in this registry
+		 * @param destination The registry the entities are moved to
+		 */
+		void Migrate(std::span<const Entity> entities, Registry& destination)
+		{
+			MigrateEntities(entities, destination);
+		}
+
+		/**
+		 * @brief Moving every entity and its components of another registry into this registry
+		 *
+		 * The entities receive new handles, use Migrate with the entities of the other registry to learn them.
+		 * Resources are not moved.
+		 *
+		 * @param source The registry whose entities are moved, it is empty afterwards
+		 */
+		void Merge(Registry& source)
+		{
+			std::vector<Entity> entities;
+			{
+			#ifdef HYPERECS_MUTEX
+				std::shared_lock<std::shared_mutex> entityLock(source.m_EntityLock);
+			#endif /* HYPERECS_MUTEX */
+
+				entities = source.m_Entities.GetEntities();
+			}
+
+			source.Migrate(entities, *this);
+		}
+
+		/**
+		 * @brief Reserving memory for components, so adding them does not reallocate the pool
+		 *
+		 * @tparam T The component class of the pool
+		 * @param count The amount of components that are going to be added
+		 */
+		template<class T>
+		void Reserve(size_t count)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+		#endif /* HYPERECS_MUTEX */
+
+			ComponentPool<T>& pool = AssureComponentPool<T>();
+
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::shared_mutex> poolLock(pool.GetLock());
+		#endif /* HYPERECS_MUTEX */
+
+			pool.Reserve(pool.Size() + count);
+		}
+
+		/**
+		 * @brief Getting the memory held by the entities, every component pool, every group and the hierarchy
+		 *
+		 * Resources and observers are not counted.
+		 *
+		 * @return Returns the memory
+		 */
+		MemoryUsage GetMemoryUsage()
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+			std::shared_lock<std::shared_mutex> entityLock(m_EntityLock);
+			std::shared_lock<std::shared_mutex> componentLock(m_ComponentLock);
+		#endif /* HYPERECS_MUTEX */
+
+			MemoryUsage memory;
+			memory.FreeEntityCount = m_Entities.GetFreeCount();
+			memory.EntityCount = m_Entities.Size() - memory.FreeEntityCount;
+			memory.EntityBytes = m_Entities.Capacity() * sizeof(Entity);
+			memory.FreeEntityBytes = memory.FreeEntityCount * sizeof(Entity);
+			memory.EntityTickBytes = m_EntityTicks.capacity() * sizeof(uint64_t);
+			memory.HierarchyBytes = m_Hierarchy.GetMemory();
+			memory.TotalBytes = memory.EntityBytes + memory.EntityTickBytes + memory.HierarchyBytes;
+
+			for (const std::unique_ptr<Group>& group : m_Groups)
+				if (group)
+					memory.GroupBytes += group->GetMemory();
+			memory.TotalBytes += memory.GroupBytes;
+
+			for (const std::unique_ptr<ComponentPoolBase>& pool : m_Components)
+			{
+				if (!pool)
+					continue;
+
+			#ifdef HYPERECS_MUTEX
+				std::shared_lock<std::shared_mutex> poolLock(pool->GetLock());
+			#endif /* HYPERECS_MUTEX */
+
+				const ComponentMemory& component = memory.Components.emplace_back(pool->GetMemoryUsage());
+				memory.TotalBytes += component.UsedBytes + component.UnusedBytes + component.SparseBytes;
+			}
+
+			if (memory.EntityCount != 0)
+			{
+				memory.EntityOverhead = static_cast<double>(memory.EntityBytes) / static_cast<double>(memory.EntityCount);
+				memory.BytesPerEntity = static_cast<double>(memory.TotalBytes) / static_cast<double>(memory.EntityCount);
+			}
+			return memory;
+		}
+
+		/**
+		 * @brief Writing the memory held by the entities, every component pool, every group and the hierarchy as JSON, the largest pools first
+		 *
+		 * @param path The path of the file that is written
+		 *
+		 * @return Returns if the file was written
+		 */
+		bool DumpMemoryUsage(const std::string& path)
+		{
+			MemoryUsage memory = GetMemoryUsage();
+			std::sort(memory.Components.begin(), memory.Components.end(), [](const ComponentMemory& left, const ComponentMemory& right)
+			{
+				return left.UsedBytes + left.UnusedBytes + left.SparseBytes > right.UsedBytes + right.UnusedBytes + right.SparseBytes;
+			});
+
+			std::ofstream file(path);
+			if (!file)
+				return false;
+
+			file << "{\"entities\":" << memory.EntityCount << ",\"free_entities\":" << memory.FreeEntityCount << ",\"entity_bytes\":" << memory.EntityBytes
+				<< ",\"free_entity_bytes\":" << memory.FreeEntityBytes << ",\"entity_overhead\":" << memory.EntityOverhead << ",\"entity_tick_bytes\":" << memory.EntityTickBytes
+				<< ",\"group_bytes\":" << memory.GroupBytes << ",\"hierarchy_bytes\":" << memory.HierarchyBytes << ",\"total_bytes\":" << memory.TotalBytes
+				<< ",\"bytes_per_entity\":" << memory.BytesPerEntity << ",\"components\":[";
+			for (size_t index = 0; index < memory.Components.size(); index++)
+			{
+				const ComponentMemory& component = memory.Components[index];
+				file << (index == 0 ? "" : ",") << "\n{\"name\":";
+				WriteJsonString(file, component.Name);
+				file << ",\"count\":" << component.Count << ",\"capacity\":" << component.Capacity
+					<< ",\"used_bytes\":" << component.UsedBytes << ",\"unused_bytes\":" << component.UnusedBytes << ",\"sparse_bytes\":" << component.SparseBytes << "}";
+			}
+			file << "\n]}\n";
+			return static_cast<bool>(file);
+		}
+
+		/**
+		 * @brief Getting the group of a component signature, creating it on first use
+		 *
+		 * The group is kept up to date by AddComponent, RemoveComponent and Destroy from then on.
+		 *
+		 * @tparam T The classes of the signature
+		 *
+		 * @return Returns the group
+		 */
+		template<class... T> requires (sizeof...(T) > 1)
+		Group& GetGroup()
+		{
+			size_t groupId = TypeIndex<Group>::Get<std::tuple<T...>>();
+			{
+			#ifdef HYPERECS_MUTEX
+				std::shared_lock<std::shared_mutex> componentLock(m_ComponentLock);
+			#endif /* HYPERECS_MUTEX */
+
+				if (groupId < m_Groups.size() && m_Groups[groupId])
+					return *m_Groups[groupId];
+			}
+
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> structureLock(m_StructureLock);
+		#endif /* HYPERECS_MUTEX */
+
+			std::vector<ComponentPoolBase*> pools = { &AssureComponentPool<T>()... };
+
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::shared_mutex> componentLock(m_ComponentLock);
+		#endif /* HYPERECS_MUTEX */
+
+			if (groupId >= m_Groups.size())
+				m_Groups.resize(groupId + 1);
+
+			std::unique_ptr<Group>& group = m_Groups[groupId];
+			if (!group)
+				group = std::make_unique<Group>(pools);
+			return *group;
+		}
+
+	private:
+		/**
+		 * @brief Calling the observers of a component event
+		 *
+		 * @param pool The pool of the component
+		 * @param event The event that happened
+		 * @param entity The entity whose component the event happened to
+		 */
+		void Notify(ComponentPoolBase& pool, ComponentEvent event, Entity entity)
+		{
+			for (const std::function<void(Registry&, Entity)>& observer : pool.GetObservers(event))
+				observer(*this, entity);
+		}
+
+		/**
+		 * @brief Removing the component of an entity from a pool and the groups of the pool
+		 *
+		 * @param pool The pool of the component
+		 * @param entity The entity whose component is getting removed
+		 */
+		void RemoveFromPool(ComponentPoolBase& pool, Entity entity)
+		{
+			for (Group* group : pool.GetGroups())
+				group->OnComponentRemoved(entity);
+			pool.Remove(entity);
+			pool.RecordRemoved(entity, m_Tick.load(std::memory_order_relaxed));
+			MarkEntity(entity);
+		}
+
+		/**
+		 * @brief Moving multiple entities and their components into another registry at once, see Migrate
+		 *
+		 * @param entities The entities that are getting moved, each at most once, they are destroyed in this registry
+		 * @param destination The registry the entities are moved to
+		 *
+		 * @return Returns the entities in the destination, in the order of the moved entities
+		 */
+		std::vector<Entity> MigrateEntities(std::span<const Entity> entities, Registry& destination)
+		{
+			if (&destination == this)
+			{
+				std::cerr << "[HyperECS] Entities can not be moved into their own registry!" << std::endl;
+				__debugbreak();
+			}
+
+			std::vector<Entity> migrated(entities.size());
+			std::vector<std::pair<ComponentPoolBase*, Entity>> removed;
+			std::vector<std::pair<ComponentPoolBase*, Entity>> added;
+			{
+			#ifdef HYPERECS_MUTEX
+				std::scoped_lock<std::mutex, std::mutex> structureLock(m_StructureLock, destination.m_StructureLock);
+				std::scoped_lock<std::shared_mutex, std::shared_mutex> entityLock(m_EntityLock, destination.m_EntityLock);
+			#endif /* HYPERECS_MUTEX */
+
+				std::vector<std::pair<size_t, ComponentPoolBase*>> pools;
+				{
+				#ifdef HYPERECS_MUTEX
+					std::shared_lock<std::shared_mutex> componentLock(m_ComponentLock);
+				#endif /* HYPERECS_MUTEX */
+
+					for (size_t componentId = 0; componentId < m_Components.size(); componentId++)
+						if (m_Components[componentId])
+							pools.emplace_back(componentId, m_Components[componentId].get());
+				}
+
+				SparseSet indices;
+				indices.Reserve(entities.size());
+				for (Entity entity : entities)
+				{
+					if (!m_Entities.IsValid(entity))
+					{
+						std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
+						__debugbreak();
+					}
+
+					if (indices.Contains(entity))
+					{
+						std::cerr << "[HyperECS] Entity is passed more than once!" << std::endl;
+						__debugbreak();
+					}
+
+					indices.Insert(entity);
+				}
+
+				destination.m_Entities.Reserve(entities.size());
+				for (Entity& entity : migrated)
+				{
+					entity = destination.m_Entities.Create();
+					destination.MarkEntity(entity);
+				}
+
+				uint64_t tick = destination.m_Tick.load(std::memory_order_relaxed);
+				std::vector<std::pair<Entity, Entity>> moved;
+				for (const auto& [componentId, pool] : pools)
+				{
+					moved.clear();
+					{
+					#ifdef HYPERECS_MUTEX
+						std::shared_lock<std::shared_mutex> poolLock(pool->GetLock());
+					#endif /* HYPERECS_MUTEX */
+
+						for (size_t index = 0; index < entities.size(); index++)
+							if (pool->Contains(entities[index]))
+								moved.emplace_back(entities[index], migrated[index]);
+					}
+
+					if (moved.empty())
+						continue;
+
+					ComponentPoolBase& destinationPool = destination.AssureComponentPool(componentId, *pool);
+
+				#ifdef HYPERECS_MUTEX
+					std::scoped_lock<std::shared_mutex, std::shared_mutex> poolLock(pool->GetLock(), destinationPool.GetLock());
+				#endif /* HYPERECS_MUTEX */
+
+					pool->MoveTo(moved, destinationPool, tick);
+
+					bool isRemovedObserved = !pool->GetObservers(ComponentEvent::Removed).empty();
+					bool isAddedObserved = !destinationPool.GetObservers(ComponentEvent::Added).empty();
+					for (const std::pair<Entity, Entity>& entity : moved)
+					{
+						RemoveFromPool(*pool, entity.first);
+						for (Group* group : destinationPool.GetGroups())
+							group->OnComponentAdded(entity.second);
+
+						if (isRemovedObserved)
+							removed.emplace_back(pool, entity.first);
+						if (isAddedObserved)
+							added.emplace_back(&destinationPool, entity.second);
+					}
+				}
+
+				for (size_t index = 0; index < entities.size(); index++)
+				{
+					size_t parent = indices.GetSlot(m_Hierarchy.GetParent(entities[index]));
+					if (parent != SparseSet::Null)
+						destination.m_Hierarchy.SetParent(migrated[index], migrated[parent]);
+				}
+
+				if (removed.empty())
+				{
+				#ifdef HYPERECS_MUTEX
+					std::shared_lock<std::shared_mutex> componentLock(m_ComponentLock);
+				#endif /* HYPERECS_MUTEX */
+
+					ReleaseEntities(entities, false);
+				}
+			}
+
+			if (!removed.empty())
+			{
+				for (const std::pair<ComponentPoolBase*, Entity>& component : removed)
+					Notify(*component.first, ComponentEvent::Removed, component.second);
+
+			#ifdef HYPERECS_MUTEX
+				std::unique_lock<std::mutex> structureLock(m_StructureLock);
+				std::unique_lock<std::shared_mutex> entityLock(m_EntityLock);
+				std::shared_lock<std::shared_mutex> componentLock(m_ComponentLock);
+			#endif /* HYPERECS_MUTEX */
+
+				ReleaseEntities(entities, true);
+			}
+
+			for (const std::pair<ComponentPoolBase*, Entity>& component : added)
+				destination.Notify(*component.first, ComponentEvent::Added, component.second);
+
+			return migrated;
+		}
+
+		/**
+		 * @brief Reporting valid entities that are passed more than once to a batched operation
+		 *
+		 * @param entities The entities that are getting checked
+		 */
+		void CheckDuplicates(std::span<const Entity> entities) const
+		{
+			if (entities.size() < 2)
+				return;
+
+			std::vector<uint32_t> indices;
+			indices.reserve(entities.size());
+			for (Entity entity : entities)
+				indices.push_back(entity.GetIndex());
+
+			std::sort(indices.begin(), indices.end());
+			if (std::adjacent_find(indices.begin(), indices.end()) != indices.end())
+			{
+				std::cerr << "[HyperECS] Entity is passed more than once!" << std::endl;
+				__debugbreak();
+			}
+		}
+
+		/**
+		 * @brief Releasing destroyed or moved entities whose components were removed, together with their relations
+		 *
+		 * The removed observers run before the release, while the entities are still alive. Components they added
+		 * to the entities in between are removed without notifying again.
+		 *
+		 * @param entities The entities that are getting released, each at most once
+		 * @param isNotified If removed observers ran since the components were removed
+		 */
+		void ReleaseEntities(std::span<const Entity> entities, bool isNotified)
+		{
+			if (isNotified)
+				for (std::unique_ptr<ComponentPoolBase>& pool : m_Components)
+				{
+					if (!pool)
+						continue;
+
+				#ifdef HYPERECS_MUTEX
+					std::unique_lock<std::shared_mutex> poolLock(pool->GetLock());
+				#endif /* HYPERECS_MUTEX */
+
+					for (Entity entity : entities)
+						if (pool->Contains(entity))
+							RemoveFromPool(*pool, entity);
+				}
+
+			for (Entity entity : entities)
+			{
+				m_Hierarchy.Remove(entity);
+				m_Entities.Release(entity);
+				MarkEntity(entity);
+			}
+		}
+
+		/**
+		 * @brief Recording that an entity was created, destroyed or lost a component or parent in the current tick
+		 *
+		 * @param entity The entity that changed
+		 */
+		void MarkEntity(Entity entity)
+		{
+			if (entity.GetIndex() >= m_EntityTicks.size())
+				m_EntityTicks.resize(m_Entities.Size());
+			m_EntityTicks[entity.GetIndex()] = m_Tick.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Moving entities to the front of a field component pool in the order they are given
+		 *
+		 * @tparam T The field component class of the pool
+		 * @param pool The pool that is getting arranged
+		 * @param entities The entities that are moved to the front, every one has a component in the pool
+		 */
+		template<class T>
+		void Arrange(ComponentPool<T>& pool, const std::vector<Entity>& entities)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::shared_mutex> poolLock(pool.GetLock());
+		#endif /* HYPERECS_MUTEX */
+
+			for (size_t index = 0; index < entities.size(); index++)
+			{
+				size_t slot = pool.GetSlot(entities[index]);
+				if (slot != index)
+					pool.SwapSlots(index, slot);
+			}
+		}
+
+		/**
+		 * @brief Getting the pool of a component class, creating it if no component of the class was added yet
+		 *
+		 * @tparam T The component class of the pool
+		 *
+		 * @return Returns the pool
+		 */
+		template<class T>
+		ComponentPool<T>& AssureComponentPool()
+		{
+			ComponentPool<T>* existing = GetComponentPool<T>();
+			if (existing != nullptr)
+				return *existing;
+
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::shared_mutex> componentLock(m_ComponentLock);
+		#endif /* HYPERECS_MUTEX */
+
+			size_t componentId = TypeIndex<ComponentPoolBase>::Get<T>();
+			if (componentId >= m_Components.size())
+				m_Components.resize(componentId + 1);
+
+			std::unique_ptr<ComponentPoolBase>& pool = m_Components[componentId];
+			if (!pool)
+			{
+				pool = std::make_unique<ComponentPool<T>>();
+				PublishComponentPool(componentId, pool.get());
+			}
+			return *static_cast<ComponentPool<T>*>(pool.get());
+		}
+
+		/**
+		 * @brief Getting the pool of a type id, creating it from the pool of another registry if it does not exist yet
+		 *
+		 * @param componentId The type id of the component class
+		 * @param prototype A pool of the component class
+		 *
+		 * @return Returns the pool
+		 */
+		ComponentPoolBase& AssureComponentPool(size_t componentId, const ComponentPoolBase& prototype)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::shared_mutex> componentLock(m_ComponentLock);
+		#endif /* HYPERECS_MUTEX */
+
+			if (componentId >= m_Components.size())
+				m_Components.resize(componentId + 1);
+
+			std::unique_ptr<ComponentPoolBase>& pool = m_Components[componentId];
+			if (!pool)
+			{
+				pool = prototype.CreateEmpty();
+				PublishComponentPool(componentId, pool.get());
+			}
+			return *pool;
+		}
+
+		/**
+		 * @brief Making a new pool visible to lookups, with HYPERECS_MUTEX m_ComponentLock is held exclusively
+		 *
+		 * @param componentId The type id of the component class
+		 * @param pool The pool of the class
+		 */
+		void PublishComponentPool(size_t componentId, ComponentPoolBase* pool)
+		{
+			size_t page = componentId / PoolPageSize;
+			if (page >= PoolPageCount)
+			{
+				std::cerr << "[HyperECS] Too many component classes!" << std::endl;
+				__debugbreak();
+			}
+
+			std::atomic<ComponentPoolBase*>* pools = m_PoolTable[page].load(std::memory_order_relaxed);
+			if (pools == nullptr)
+			{
+				pools = m_PoolPages.emplace_back(std::make_unique<std::atomic<ComponentPoolBase*>[]>(PoolPageSize)).get();
+				m_PoolTable[page].store(pools, std::memory_order_release);
+			}
+			pools[componentId % PoolPageSize].store(pool, std::memory_order_release);
+		}
+
+		/**
+		 * @brief Adding components to multiple entities, growing the pool once
+		 *
+		 * @tparam T The component class that is getting created
+		 * @tparam Source The type of the function that provides the components
+		 * @param entities The entities that the components getting assigned to, each at most once
+		 * @param source Function that returns the component of the entity at an index
+		 */
+		template<class T, class Source>
+		void EmplaceComponents(std::span<const Entity> entities, Source&& source)
+		{
+			ComponentPool<T>* pool = nullptr;
+			{
+			#ifdef HYPERECS_MUTEX
+				std::unique_lock<std::mutex> structureLock(m_StructureLock);
+				std::shared_lock<std::shared_mutex> entityLock(m_EntityLock);
+			#endif /* HYPERECS_MUTEX */
+
+				pool = &AssureComponentPool<T>();
+
+			#ifdef HYPERECS_MUTEX
+				std::unique_lock<std::shared_mutex> poolLock(pool->GetLock());
+			#endif /* HYPERECS_MUTEX */
+
+				for (Entity entity : entities)
+				{
+					if (!m_Entities.IsValid(entity))
+					{
+						std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
+						__debugbreak();
+					}
+
+					if (pool->Contains(entity))
+					{
+						std::cerr << "[HyperECS] Entity already has the component!" << std::endl;
+						__debugbreak();
+					}
+				}
+
+				uint64_t tick = m_Tick.load(std::memory_order_relaxed);
+				pool->Reserve(pool->Size() + entities.size());
+				for (size_t index = 0; index < entities.size(); index++)
+				{
+					/* The entities were checked against the pool before, so an entity that is in it by now was passed twice */
+					if (pool->Contains(entities[index]))
+					{
+						std::cerr << "[HyperECS] Entity is passed more than once!" << std::endl;
+						__debugbreak();
+					}
+
+					pool->Emplace(entities[index], tick, source(index));
+				}
+
+				for (Group* group : pool->GetGroups())
+					for (Entity entity : entities)
+						group->OnComponentAdded(entity);
+			}
+
+			if (!pool->GetObservers(ComponentEvent::Added).empty())
+				for (Entity entity : entities)
+					Notify(*pool, ComponentEvent::Added, entity);
+		}
+
+		/**
+		 * @brief Reporting a component lookup that failed, telling stale entities apart from missing components
+		 *
+		 * @param entity The entity whose component was not found
+		 */
+		[[noreturn]] void ReportMissingComponent(Entity entity)
+		{
+			if (!IsValid(entity))
+			{
+				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
+				__debugbreak();
+			}
+
+			std::cerr << "[HyperECS] Entity has not the component!" << std::endl;
+			__debugbreak();
+			std::abort();
+		}
+
+		/**
+		 * @brief Creating the pools of every component class that was registered in any registry
+		 */
+		void AssureRegisteredComponentPools()
+		{
+			std::unique_lock<std::mutex> registeredComponentLock(s_RegisteredComponentLock);
+			for (const RegisteredComponent& component : s_RegisteredComponents)
+				AssureComponentPool(component.ComponentId, *component.Prototype);
+		}
+
+		/**
+		 * @brief Getting the pool of a component class without taking a lock
+		 *
+		 * @tparam T The component class of the pool
+		 *
+		 * @return Returns the pool or nullptr if no component of the class was added yet
+		 */
+		template<class T>
+		ComponentPool<T>* GetComponentPool()
+		{
+			size_t componentId = TypeIndex<ComponentPoolBase>::Get<T>();
+			if (componentId / PoolPageSize >= PoolPageCount)
+				return nullptr;
+
+			std::atomic<ComponentPoolBase*>* pools = m_PoolTable[componentId / PoolPageSize].load(std::memory_order_acquire);
+			if (pools == nullptr)
+				return nullptr;
+			return static_cast<ComponentPool<T>*>(pools[componentId % PoolPageSize].load(std::memory_order_acquire));
+		}
+	};
+
+	/* Type erased interface of the recorded components of one class */
+	class CommandPoolBase
+	{
+	public:
+		virtual ~CommandPoolBase() = default;
+
+		/**
+		 * @brief Reserving memory in the registry for the recorded components
+		 *
+		 * @param registry The registry the commands are played back on
+		 */
+		virtual void Reserve(Registry& registry) = 0;
+
+		/**
+		 * @brief Adding recorded components to entities in one batch
+		 *
+		 * @param registry The registry the commands are played back on
+		 * @param entities The entities that the components getting assigned to
+		 * @param slot The slot of the recorded component of the first entity, the others follow back to back
+		 */
+		virtual void Add(Registry& registry, std::span<const Entity> entities, size_t slot) = 0;
+
+		/**
+		 * @brief Removing the component from an entity
+		 *
+		 * @param registry The registry the commands are played back on
+		 * @param entity The entity where component getting removed
+		 */
+		virtual void Remove(Registry& registry, Entity entity) = 0;
+
+		/**
+		 * @brief Destroying the recorded components
+		 */
+		virtual void Clear() = 0;
+	};
+
+	/* Recorded components of one class, stored back to back until they are played back */
+	template<class T>
+	class CommandPool : public CommandPoolBase
+	{
+	private:
+		/* Holds the recorded components */
+		std::vector<T, typename ComponentAllocator<T>::Type> m_Components;
+
+	public:
+		/**
+		 * @brief Recording a component
+		 *
+		 * @tparam Args The arguments for the class
+		 * @param args The arguments for the class
+		 *
+		 * @return Returns the slot of the component
+		 */
+		template<typename... Args>
+		size_t Emplace(Args&&... args)
+		{
+			m_Components.emplace_back(std::forward<Args>(args)...);
+			return m_Components.size() - 1;
+		}
+
+		/**
+		 * @brief Reserving memory in the pool of the registry for the recorded components
+		 *
+		 * @param registry The registry the commands are played back on
+		 */
+		void Reserve(Registry& registry) override
+		{
+			registry.Reserve<T>(m_Components.size());
+		}
+
+		/**
+		 * @brief Moving recorded components into the registry in one batch
+		 *
+		 * @param registry The registry the commands are played back on
+		 * @param entities The entities that the components getting assigned to
+		 * @param slot The slot of the recorded component of the first entity, the others follow back to back
+		 */
+		void Add(Registry& registry, std::span<const Entity> entities, size_t slot) override
+		{
+			registry.AddComponents<T>(entities, std::span<T>(m_Components).subspan(slot, entities.size()));
+		}
+
+		/**
+		 * @brief Removing the component from an entity
+		 *
+		 * @param registry The registry the commands are played back on
+		 * @param entity The entity where component getting removed
+		 */
+		void Remove(Registry& registry, Entity entity) override
+		{
+			registry.RemoveComponent<T>(entity);
+		}
+
+		/**
+		 * @brief Destroying the recorded components
+		 */
+		void Clear() override
+		{
+			m_Components.clear();
+		}
+	};
+
+	/* Records structural changes and plays them back in one batch, so they can be made while iterating or from multiple threads */
+	class CommandBuffer
+	{
+	private:
+		/* Kind of a recorded change */
+		enum class CommandType
+		{
+			Destroy,
+			AddComponent,
+			RemoveComponent
+		};
+
+		/* Recorded change of an entity */
+		struct Command
+		{
+			/* The kind of the change */
+			CommandType Type;
+
+			/* The entity that is changed, a placeholder for entities constructed by the buffer */
+			Entity Target;
+
+			/* The components of the change, nullptr for Destroy */
+			CommandPoolBase* Pool;
+
+			/* The slot of the added component in the pool */
+			size_t Slot;
+		};
+
+		/* Holds the changes in the order they were recorded */
+		std::vector<Command> m_Commands;
+
+		/* Holds the recorded components of every component class at the type id of the class */
+		std::vector<std::unique_ptr<CommandPoolBase>> m_Pools;
+
+		/* Amount of entities that are constructed on playback */
+		uint32_t m_ConstructCount = 0;
+
+		/* Mutex & Lock for recording */
+		std::mutex m_CommandLock;
+
+	public:
+		/**
+		 * @brief Creating an empty buffer
+		 *
+		 * @param capacity The amount of changes the buffer can hold without reallocating
+		 */
+		explicit CommandBuffer(size_t capacity = 0)
+		{
+			m_Commands.reserve(capacity);
+		}
+
+		CommandBuffer(const CommandBuffer&) = delete;
+		CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+		/**
+		 * @brief Recording the construction of an entity
+		 *
+		 * The returned placeholder can be passed to the other commands of this buffer and becomes a real entity on playback.
+		 *
+		 * @return Returns a placeholder for the entity
+		 */
+		Entity Construct()
+		{
+			std::unique_lock<std::mutex> commandLock(m_CommandLock);
+			return Entity::Create(++m_ConstructCount, 0);
+		}
+
+		/**
+		 * @brief Recording the destruction of an entity and its components
+		 *
+		 * @param entity Entity that is getting destroyed
+		 */
+		void Destroy(Entity entity)
+		{
+			std::unique_lock<std::mutex> commandLock(m_CommandLock);
+			m_Commands.push_back({ CommandType::Destroy, entity, nullptr, 0 });
+		}
+
+		/**
+		 * @brief Recording the addition of a component to an entity, the component is constructed right away
+		 *
+		 * @tparam T The component class that is getting created
+		 * @tparam Args The arguments for the class
+		 * @param entity The corresponding entity that the component getting assigned to
+		 * @param args The arguments for the class
+		 */
+		template<class T, typename... Args>
+		void AddComponent(Entity entity, Args&&... args)
+		{
+			std::unique_lock<std::mutex> commandLock(m_CommandLock);
+			CommandPool<T>& pool = AssureCommandPool<T>();
+			size_t slot = pool.Emplace(std::forward<Args>(args)...);
+			m_Commands.push_back({ CommandType::AddComponent, entity, &pool, slot });
+		}
+
+		/**
+		 * @brief Recording the removal of a component from an entity
+		 *
+		 * @tparam T The component class that is getting removed
+		 * @param entity The corresponding entity where component getting removed
+		 */
+		template<class T>
+		void RemoveComponent(Entity entity)
+		{
+			std::unique_lock<std::mutex> commandLock(m_CommandLock);
+			m_Commands.push_back({ CommandType::RemoveComponent, entity, &AssureCommandPool<T>(), 0 });
+		}
+
+		/**
+		 * @brief Applying the recorded changes in the order they were recorded and clearing the buffer
+		 *
+		 * Entities are constructed first and every touched pool is grown once up front.
+		 * Consecutive additions are applied in one batch per component class, in the order the classes were first added.
+		 * Must not run while the registry is iterated.
+		 *
+		 * @param registry The registry the changes are applied to
+		 */
+		void Playback(Registry& registry)
+		{
+			std::unique_lock<std::mutex> commandLock(m_CommandLock);
+
+			std::vector<Entity> constructed;
+			constructed.reserve(m_ConstructCount);
+			registry.Construct(m_ConstructCount, std::back_inserter(constructed));
+
+			for (std::unique_ptr<CommandPoolBase>& pool : m_Pools)
+				if (pool)
+					pool->Reserve(registry);
+
+			auto resolve = [&](Entity target) { return target.GetGeneration() == 0 ? constructed[target.GetIndex() - 1] : target; };
+
+			std::vector<Entity> entities;
+			std::vector<CommandPoolBase*> batched;
+			size_t index = 0;
+			while (index < m_Commands.size())
+			{
+				const Command& command = m_Commands[index];
+				if (command.Type == CommandType::Destroy)
+				{
+					registry.Destroy(resolve(command.Target));
+					index++;
+					continue;
+				}
+
+				if (command.Type == CommandType::RemoveComponent)
+				{
+					command.Pool->Remove(registry, resolve(command.Target));
+					index++;
+					continue;
+				}
+
+				/* The slots of one class within a run of additions are back to back, since they were recorded in this order */
+				size_t end = index;
+				while (end < m_Commands.size() && m_Commands[end].Type == CommandType::AddComponent)
+					end++;
+
+				batched.clear();
+				for (size_t first = index; first < end; first++)
+				{
+					CommandPoolBase* pool = m_Commands[first].Pool;
+					if (std::find(batched.begin(), batched.end(), pool) != batched.end())
+						continue;
+
+					batched.push_back(pool);
+					entities.clear();
+					for (size_t next = first; next < end; next++)
+						if (m_Commands[next].Pool == pool)
+							entities.push_back(resolve(m_Commands[next].Target));
+					pool->Add(registry, entities, m_Commands[first].Slot);
+				}
+				index = end;
+			}
+
+			m_Commands.clear();
+			for (std::unique_ptr<CommandPoolBase>& pool : m_Pools)
+				if (pool)
+					pool->Clear();
+			m_ConstructCount = 0;
+		}
+
+		/**
+		 * @brief Check if the buffer has no recorded changes
+		 *
+		 * @return Returns if the buffer was empty
+		 */
+		bool IsEmpty()
+		{
+			std::unique_lock<std::mutex> commandLock(m_CommandLock);
+			return m_Commands.empty() && m_ConstructCount == 0;
+		}
+
+	private:
+		/**
+		 * @brief Getting the recorded components of a class, creating the storage on first use
+		 *
+		 * @tparam T The component class
+		 *
+		 * @return Returns the recorded components
+		 */
+		template<class T>
+		CommandPool<T>& AssureCommandPool()
+		{
+			size_t componentId = TypeIndex<ComponentPoolBase>::Get<T>();
+			if (componentId >= m_Pools.size())
+				m_Pools.resize(componentId + 1);
+
+			std::unique_ptr<CommandPoolBase>& pool = m_Pools[componentId];
+			if (!pool)
+				pool = std::make_unique<CommandPool<T>>();
+			return *static_cast<CommandPool<T>*>(pool.get());
+		}
+	};
+
+	/* Size, alignment and lifetime functions of a component class for type erased storage */
+	struct ComponentInfo
+	{
+		/* Size of the component class */
+		size_t Size;
+
+		/* Alignment of the component class */
+		size_t Alignment;
+
+		/* Move constructs a component into uninitialized memory */
+		void (*MoveConstruct)(void* destination, void* source);
+
+		/* Calls the destructor of a component */
+		void (*Destroy)(void* component);
+
+		/**
+		 * @brief Creating the info of a component class
+		 *
+		 * @tparam T The component class
+		 *
+		 * @return Returns the info of the component class
+		 */
+		template<class T>
+		static ComponentInfo Create()
+		{
+			return ComponentInfo({ sizeof(T), alignof(T),
+				[](void* destination, void* source) { new (destination) T(std::move(*static_cast<T*>(source))); },
+				[](void* component) { static_cast<T*>(component)->~T(); } });
+		}
+	};
+
+	/* Table of all entities with the same set of components, stored as one array per component inside fixed size chunks */
+	class Archetype
+	{
+	public:
+		/* Column of an entity that is not part of the archetype */
+		static constexpr size_t Null = std::numeric_limits<size_t>::max();
+
+		/* Amount of bytes of a chunk */
+		static constexpr size_t ChunkSize = 16384;
+
+	private:
+		/* Component array inside of a chunk */
+		struct Column
+		{
+			/* Type id of the component, given by TypeIndex<ComponentPoolBase> */
+			size_t Component;
+
+			/* Info of the component class */
+			ComponentInfo Info;
+
+			/* Byte offset of the array from the begin of a chunk */
+			size_t Offset;
+		};
+
+		/* Holds the columns sorted by the type id of the component */
+		std::vector<Column> m_Columns;
+
+		/* Holds the entities of all rows */
+		std::vector<Entity> m_Entities;
+
+		/* Holds the chunks with the component arrays */
+		std::vector<std::byte*> m_Chunks;
+
+		/* Amount of rows that fit into a chunk */
+		size_t m_ChunkCapacity = 0;
+
+		/* Amount of bytes of a chunk including the alignment padding */
+		size_t m_ChunkBytes = 0;
+
+		/* Alignment of a chunk */
+		size_t m_ChunkAlignment = alignof(std::max_align_t);
+
+		/* Holds the archetypes that are reached by adding a component */
+		std::unordered_map<size_t, Archetype*> m_AddEdges;
+
+		/* Holds the archetypes that are reached by removing a component */
+		std::unordered_map<size_t, Archetype*> m_RemoveEdges;
+
+	public:
+		/**
+		 * @brief Creating an archetype for a set of components
+		 *
+		 * @param components The type ids and infos of the components, sorted by type id
+		 */
+		Archetype(const std::vector<std::pair<size_t, ComponentInfo>>& components)
+		{
+			size_t rowSize = 0;
+			for (const auto& component : components)
+			{
+				rowSize += component.second.Size;
+				m_ChunkAlignment = std::max(m_ChunkAlignment, component.second.Alignment);
+			}
+			m_ChunkCapacity = std::max<size_t>(1, ChunkSize / std::max<size_t>(1, rowSize));
+
+			for (const auto& component : components)
+			{
+				m_ChunkBytes = (m_ChunkBytes + component.second.Alignment - 1) / component.second.Alignment * component.second.Alignment;
+				m_Columns.push_back({ component.first, component.second, m_ChunkBytes });
+				m_ChunkBytes += component.second.Size * m_ChunkCapacity;
+			}
+		}
+
+		~Archetype()
+		{
+			for (size_t row = 0; row < m_Entities.size(); row++)
+				for (size_t column = 0; column < m_Columns.size(); column++)
+					m_Columns[column].Info.Destroy(Get(column, row));
+
+			for (std::byte* chunk : m_Chunks)
+				::operator delete(chunk, std::align_val_t(m_ChunkAlignment));
+		}
+
+		Archetype(const Archetype&) = delete;
+		Archetype& operator=(const Archetype&) = delete;
+
+		/**
+		 * @brief Appending an uninitialized row for an entity
+		 *
+		 * @param entity The entity of the row
+		 *
+		 * @return Returns the row
+		 */
+		size_t Allocate(Entity entity)
+		{
+			if (m_Entities.size() == m_Chunks.size() * m_ChunkCapacity)
+				m_Chunks.push_back(static_cast<std::byte*>(::operator new(std::max<size_t>(1, m_ChunkBytes), std::align_val_t(m_ChunkAlignment))));
+
+			m_Entities.push_back(entity);
+			return m_Entities.size() - 1;
+		}
+
+		/**
+		 * @brief Destroying the components of a row and moving the last row into it
+		 *
+		 * @param row The row that is getting removed
+		 *
+		 * @return Returns the entity that was moved into the row or an invalid entity if the last row was removed
+		 */
+		Entity Remove(size_t row)
+		{
+			size_t last = m_Entities.size() - 1;
+			for (size_t column = 0; column < m_Columns.size(); column++)
+			{
+				m_Columns[column].Info.Destroy(Get(column, row));
+				if (row != last)
+				{
+					m_Columns[column].Info.MoveConstruct(Get(column, row), Get(column, last));
+					m_Columns[column].Info.Destroy(Get(column, last));
+				}
+			}
+
+			Entity moved = row != last ? m_Entities[last] : Entity({ 0 });
+			m_Entities[row] = m_Entities[last];
+			m_Entities.pop_back();
+			return moved;
+		}
+
+		/**
+		 * @brief Getting the column of a component
+		 *
+		 * @param component The type id of the component
+		 *
+		 * @return Returns the column or Null if the archetype has not the component
+		 */
+		size_t GetColumn(size_t component) const
+		{
+			auto column = std::lower_bound(m_Columns.begin(), m_Columns.end(), component, [](const Column& column, size_t component) { return column.Component < component; });
+			if (column == m_Columns.end() || column->Component != component)
+				return Null;
+			return static_cast<size_t>(column - m_Columns.begin());
+		}
+
+		/**
+		 * @brief Getting the component of a row
+		 *
+		 * @param column The column of the component
+		 * @param row The row of the entity
+		 *
+		 * @return Returns a pointer to the component
+		 */
+		void* Get(size_t column, size_t row) const
+		{
+			return m_Chunks[row / m_ChunkCapacity] + m_Columns[column].Offset + (row % m_ChunkCapacity) * m_Columns[column].Info.Size;
+		}
+
+		/**
+		 * @brief Getting the begin of a component array inside of a chunk
+		 *
+		 * @param column The column of the component
+		 * @param chunk The chunk of the array
+		 *
+		 * @return Returns a pointer to the first component of the chunk
+		 */
+		void* GetChunkColumn(size_t column, size_t chunk) const
+		{
+			return m_Chunks[chunk] + m_Columns[column].Offset;
+		}
+
+		/**
+		 * @brief Getting the components of the archetype
+		 *
+		 * @return Returns the type ids and infos of the components, sorted by type id
+		 */
+		std::vector<std::pair<size_t, ComponentInfo>> GetComponents() const
+		{
+			std::vector<std::pair<size_t, ComponentInfo>> components;
+			for (const Column& column : m_Columns)
+				components.emplace_back(column.Component, column.Info);
+			return components;
+		}
+
+		/**
+		 * @brief Getting the type id of the component in a column
+		 *
+		 * @param column The column of the component
+		 *
+		 * @return Returns the type id of the component
+		 */
+		size_t GetComponent(size_t column) const
+		{
+			return m_Columns[column].Component;
+		}
+
+		/**
+		 * @brief Getting the info of the component in a column
+		 *
+		 * @param column The column of the component
+		 *
+		 * @return Returns the info of the component
+		 */
+		const ComponentInfo& GetInfo(size_t column) const
+		{
+			return m_Columns[column].Info;
+		}
+
+		/**
+		 * @brief Getting the amount of columns
+		 *
+		 * @return Returns the amount of columns
+		 */
+		size_t GetColumnCount() const
+		{
+			return m_Columns.size();
+		}
+
+		/**
+		 * @brief Getting the entities of all rows
+		 *
+		 * @return Returns the entities of the archetype
+		 */
+		const std::vector<Entity>& GetEntities() const
+		{
+			return m_Entities;
+		}
+
+		/**
+		 * @brief Getting the amount of rows that fit into a chunk
+		 *
+		 * @return Returns the chunk capacity
+		 */
+		size_t GetChunkCapacity() const
+		{
+			return m_ChunkCapacity;
+		}
+
+		/**
+		 * @brief Getting the archetype that is reached by adding or removing a component
+		 *
+		 * @param component The type id of the component
+		 * @param add If the component is added or removed
+		 *
+		 * @return Returns the archetype or nullptr if the edge was not created yet
+		 */
+		Archetype* GetEdge(size_t component, bool add) const
+		{
+			const std::unordered_map<size_t, Archetype*>& edges = add ? m_AddEdges : m_RemoveEdges;
+			auto edge = edges.find(component);
+			return edge != edges.end() ? edge->second : nullptr;
+		}
+
+		/**
+		 * @brief Caching the archetype that is reached by adding or removing a component
+		 *
+		 * @param component The type id of the component
+		 * @param add If the component is added or removed
+		 * @param archetype The archetype that is reached
+		 */
+		void SetEdge(size_t component, bool add, Archetype* archetype)
+		{
+			(add ? m_AddEdges : m_RemoveEdges)[component] = archetype;
+		}
+	};
+
+	/* Standalone registry that stores entities with the same set of components together in archetype tables, World always uses the sparse set Registry */
+	class ArchetypeRegistry
+	{
+	private:
+		/* Location of an entity */
+		struct EntityRecord
+		{
+			/* The archetype that holds the entity */
+			Archetype* Table;
+
+			/* The row of the entity in the archetype */
+			size_t Row;
+		};
+
+		/* Holds the archetypes by their sorted component type ids */
+		std::map<std::vector<size_t>, std::unique_ptr<Archetype>> m_Archetypes;
+
+		/* Holds the entities */
+		EntityPool m_Entities;
+
+		/* Holds the location of every entity index */
+		std::vector<EntityRecord> m_Records;
+
+		/* Archetype of entities without components */
+		Archetype* m_Root;
+
+	#ifdef HYPERECS_MUTEX
+		/* Mutex & Lock for the entities and archetypes */
+		std::mutex m_EntityLock;
+	#endif /* HYPERECS_MUTEX */
+
+	public:
+		ArchetypeRegistry()
+		{
+			m_Root = GetArchetype({});
+		}
+
+		/**
+		 * @brief Constructing an entity in the registry
+		 *
+		 * @return Returns an entity
+		 */
+		Entity Construct()
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			Entity entity = m_Entities.Create();
+			if (entity.GetIndex() >= m_Records.size())
+				m_Records.resize(entity.GetIndex() + 1);
+			m_Records[entity.GetIndex()] = { m_Root, m_Root->Allocate(entity) };
+			return entity;
+		}
+
+		/**
+		 * @brief Destroying an entity and its components in the registry
+		 *
+		 * @param entity Entity that is getting destroyed
+		 */
+		void Destroy(Entity entity)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			if (!m_Entities.IsValid(entity))
+			{
+				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
+				__debugbreak();
+			}
+
+			EntityRecord& record = m_Records[entity.GetIndex()];
+			Entity moved = record.Table->Remove(record.Row);
+			if (moved.IsHandleValid())
+				m_Records[moved.GetIndex()].Row = record.Row;
+
+			m_Entities.Release(entity);
+		}
+
+		/**
+		 * @brief Check if an entity is alive, stale handles of destroyed entities are not
+		 *
+		 * @param entity The entity that is getting checked
+		 *
+		 * @return Returns if the entity was alive
+		 */
+		bool IsValid(Entity entity)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			return m_Entities.IsValid(entity);
+		}
+
+		/**
+		 * @brief Adding component to an entity, moving the entity into the archetype with the component
+		 *
+		 * The returned reference stays valid until the archetype of any entity in the same archetype changes.
+		 *
+		 * @tparam T The component class that is getting created
+		 * @tparam Args The arguments for the class
+		 * @param entity The corresponding entity that the component getting assigned to
+		 * @param args The arguments for the class
+		 *
+		 * @return Returns the created component
+		 */
+		template<class T, typename... Args>
+		T& AddComponent(Entity entity, Args&&... args)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			if (!m_Entities.IsValid(entity))
+			{
+				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
+				__debugbreak();
+			}
+
+			size_t componentId = TypeIndex<ComponentPoolBase>::Get<T>();
+			EntityRecord& record = m_Records[entity.GetIndex()];
+			if (record.Table->GetColumn(componentId) != Archetype::Null)
+			{
+				std::cerr << "[HyperECS] Entity already has the component!" << std::endl;
+				__debugbreak();
+			}
+
+			Archetype* target = record.Table->GetEdge(componentId, true);
+			if (target == nullptr)
+			{
+				std::vector<std::pair<size_t, ComponentInfo>> components = record.Table->GetComponents();
+				components.insert(std::lower_bound(components.begin(), components.end(), componentId, [](const auto& component, size_t id) { return component.first < id; }), { componentId, ComponentInfo::Create<T>() });
+				target = GetArchetype(components);
+				record.Table->SetEdge(componentId, true, target);
+				target->SetEdge(componentId, false, record.Table);
+			}
+
+			MoveEntity(entity, target);
+			return *new (target->Get(target->GetColumn(componentId), record.Row)) T(std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief Removing component from an entity, moving the entity into the archetype without the component
+		 *
+		 * @tparam T The component class that is getting removed
+		 * @param entity The corresponding entity where component getting removed
+		 */
+		template<class T>
+		void RemoveComponent(Entity entity)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			if (!m_Entities.IsValid(entity))
+			{
+				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
+				__debugbreak();
+			}
+
+			size_t componentId = TypeIndex<ComponentPoolBase>::Get<T>();
+			EntityRecord& record = m_Records[entity.GetIndex()];
+			if (record.Table->GetColumn(componentId) == Archetype::Null)
+			{
+				std::cerr << "[HyperECS] Entity has not the component!" << std::endl;
+				__debugbreak();
+			}
+
+			Archetype* target = record.Table->GetEdge(componentId, false);
+			if (target == nullptr)
+			{
+				std::vector<std::pair<size_t, ComponentInfo>> components = record.Table->GetComponents();
+				components.erase(std::find_if(components.begin(), components.end(), [&](const auto& component) { return component.first == componentId; }));
+				target = GetArchetype(components);
+				record.Table->SetEdge(componentId, false, target);
+				target->SetEdge(componentId, true, record.Table);
+			}
+
+			MoveEntity(entity, target);
+		}
+
+		/**
+		 * @brief Removing multiple components from an entity
+		 *
+		 * @tparam T The component classes that are getting removed
+		 * @param entity The corresponding entity where component getting removed
+		 */
+		template<class... T>
+		void RemoveMultipleComponent(Entity entity)
+		{
+			(RemoveComponent<T>(entity), ...);
+		}
+
+		/**
+		 * @brief Getting component from an entity
+		 *
+		 * @tparam T The component class that is searched for
+		 * @param entity The corresponding entity that the component is assigned to
+		 *
+		 * @return Returns the corresponding component
+		 */
+		template<class T>
+		T& GetComponent(Entity entity)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			if (!m_Entities.IsValid(entity))
+			{
+				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
+				__debugbreak();
+			}
+
+			const EntityRecord& record = m_Records[entity.GetIndex()];
+			size_t column = record.Table->GetColumn(TypeIndex<ComponentPoolBase>::Get<T>());
+			if (column == Archetype::Null)
+			{
+				std::cerr << "[HyperECS] Entity has not the component!" << std::endl;
+				__debugbreak();
+			}
+
+			return *static_cast<T*>(record.Table->Get(column, record.Row));
+		}
+
+		/**
+		 * @brief Check if an entity has a component
+		 *
+		 * @tparam T The component class that is getting checked
+		 * @param entity The corresponding entity that the component is assigned to
+		 *
+		 * @return Returns if the component was found
+		 */
+		template<class T>
+		bool HasComponent(Entity entity)
+		{
+		#ifdef HYPERECS_MUTEX
+			std::unique_lock<std::mutex> entityLock(m_EntityLock);
+		#endif /* HYPERECS_MUTEX */
+
+			if (!m_Entities.IsValid(entity))
+			{
+				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
+				__debugbreak();
+			}
+
+			return m_Records[entity.GetIndex()].Table->GetColumn(TypeIndex<ComponentPoolBase>::Get<T>()) != Archetype::Null;
+		}
+
+		/**
+		 * @brief Check if an entity has multiple components
+		 *
+		 * @tparam T The component classes that are getting checked
+		 * @param entity The corresponding entity that the component is assigned to
+		 *
+		 * @return Returns if the components were found
+		 */
+		template<class... T>
+		bool HasMultipleComponent(Entity entity)
+		{
+			return (HasComponent<T>(entity) && ...);
+		}
+
+		/**
+		 * @brief Calling a function for every entity
+		 *
+		 * @tparam Function The type of the function, invocable with an entity
+		 * @param function Function that is getting called for every entity
+		 */
+		template<class Function>
+		void Each(Function&& function)
+		{
+			m_Entities.Each(function);
+		}
+
+		/**
+		 * @brief Calling a function for every entity with specified components
+		 *
+		 * Only the archetypes that hold all components are visited, chunk by chunk.
+		 *
+		 * @tparam T The classes that are getting filtered
+		 * @tparam Function The type of the function, invocable with an entity and references to the components
+		 * @param function Function that is getting called for every entity that has the specified components
+		 */
+		template<class... T, class Function> requires (sizeof...(T) > 0)
+		void Each(Function&& function)
+		{
+			for (auto& archetype : m_Archetypes)
+			{
+				Archetype& table = *archetype.second;
+				size_t columns[] = { table.GetColumn(TypeIndex<ComponentPoolBase>::Get<T>())... };
+				if (table.GetEntities().empty() || std::find(std::begin(columns), std::end(columns), Archetype::Null) != std::end(columns))
+					continue;
+
+				const std::vector<Entity>& entities = table.GetEntities();
+				size_t capacity = table.GetChunkCapacity();
+				auto lambda = [&]<size_t... I>(std::index_sequence<I...>)
+				{
+					for (size_t chunk = 0; chunk * capacity < entities.size(); chunk++)
+					{
+						size_t rows = std::min(capacity, entities.size() - chunk * capacity);
+						std::tuple<T*...> arrays = { static_cast<T*>(table.GetChunkColumn(columns[I], chunk))... };
+						for (size_t row = 0; row < rows; row++)
+							function(entities[chunk * capacity + row], std::get<I>(arrays)[row]...);
+					}
+				};
+				lambda(std::index_sequence_for<T...>());
+			}
+		}
+
+		/**
+		 * @brief Getting all entities
+		 *
+		 * @return Returns all entities
+		 */
+		std::vector<Entity> GetEntities() const
+		{
+			return m_Entities.GetEntities();
+		}
+
+		/**
+		 * @brief Getting all entities with specified components
+		 *
+		 * @tparam T The classes that are getting filtered
+		 *
+		 * @return Returns all entities with specified components
+		 */
+		template<class... T> requires (sizeof...(T) > 0)
+		std::vector<Entity> GetEntities()
+		{
+			std::vector<Entity> entities;
+			for (auto& archetype : m_Archetypes)
+				if (((archetype.second->GetColumn(TypeIndex<ComponentPoolBase>::Get<T>()) != Archetype::Null) && ...))
+					entities.insert(entities.end(), archetype.second->GetEntities().begin(), archetype.second->GetEntities().end());
+			return entities;
+		}
+
+	private:
+		/**
+		 * @brief Getting or creating the archetype of a set of components
+		 *
+		 * @param components The type ids and infos of the components, sorted by type id
+		 *
+		 * @return Returns the archetype
+		 */
+		Archetype* GetArchetype(const std::vector<std::pair<size_t, ComponentInfo>>& components)
+		{
+			std::vector<size_t> signature;
+			for (const auto& component : components)
+				signature.push_back(component.first);
+
+			std::unique_ptr<Archetype>& archetype = m_Archetypes[signature];
+			if (!archetype)
+				archetype = std::make_unique<Archetype>(components);
+			return archetype.get();
+		}
+
+		/**
+		 * @brief Moving an entity with the components both archetypes share into another archetype
+		 *
+		 * @param entity The entity that is getting moved
+		 * @param target The archetype the entity is moved to
+		 */
+		void MoveEntity(Entity entity, Archetype* target)
+		{
+			EntityRecord& record = m_Records[entity.GetIndex()];
+			Archetype* source = record.Table;
+
+			size_t row = target->Allocate(entity);
+			for (size_t column = 0; column < target->GetColumnCount(); column++)
+			{
+				size_t sourceColumn = source->GetColumn(target->GetComponent(column));
+				if (sourceColumn != Archetype::Null)
+					target->GetInfo(column).MoveConstruct(target->Get(column, row), source->Get(sourceColumn, record.Row));
+			}
+
+			Entity moved = source->Remove(record.Row);
+			if (moved.IsHandleValid())
+				m_Records[moved.GetIndex()].Row = record.Row;
+
+			record = { target, row };
+		}
+	};
+
+	class System
+	{
+	private:
+		/* Holds the type ids of the components the system reads */
+		std::vector<size_t> m_ReadComponents;
+
+		/* Holds the type ids of the components the system writes */
+		std::vector<size_t> m_WriteComponents;
+
+		/* If the system declared its component access, otherwise it is run exclusively */
+		bool m_HasAccess = false;
+
+	#ifdef HYPERECS_PROFILE
+		/* Holds the timings of every phase */
+		SystemProfile m_Profiles[3];
+	#endif /* HYPERECS_PROFILE */
+
+	public:
+		virtual ~System() = default;
+
+	#ifdef HYPERECS_PROFILE
+		/**
+		 * @brief Getting the timings of a phase of the system
+		 *
+		 * @param phase The phase
+		 *
+		 * @return Returns the timings
+		 */
+		SystemProfile& GetProfile(SystemPhase phase)
+		{
+			return m_Profiles[static_cast<size_t>(phase)];
+		}
+	#endif /* HYPERECS_PROFILE */
+
+		/**
+		 * @brief Check if the system must not run at the same time as another system
+		 *
+		 * Systems conflict if one writes a component the other reads or writes, or if one did not declare its access.
+		 *
+		 * @param other The other system
+		 *
+		 * @return Returns if the systems conflict
+		 */
+		bool ConflictsWith(const System& other) const
+		{
+			if (!m_HasAccess || !other.m_HasAccess)
+				return true;
+
+			auto intersects = [](const std::vector<size_t>& left, const std::vector<size_t>& right)
+			{
+				for (size_t component : left)
+					if (std::find(right.begin(), right.end(), component) != right.end())
+						return true;
+				return false;
+			};
+			return intersects(m_WriteComponents, other.m_ReadComponents) || intersects(m_WriteComponents, other.m_WriteComponents) || intersects(m_ReadComponents, other.m_WriteComponents);
+		}
+
+	protected:
+		/**
+		 * @brief Declaring components the system only reads, called from the constructor of the system
+		 *
+		 * Systems that declared their access run concurrently with other systems they do not conflict with, so they must
+		 * not construct or destroy entities, add or remove components or touch components they did not declare.
+		 *
+		 * @tparam T The component classes that are read
+		 */
+		template<class... T>
+		void Read()
+		{
+			m_HasAccess = true;
+			(m_ReadComponents.push_back(TypeIndex<ComponentPoolBase>::Get<T>()), ...);
+		}
+
+		/**
+		 * @brief Declaring components the system reads and writes, called from the constructor of the system
+		 *
+		 * @tparam T The component classes that are written
+		 */
+		template<class... T>
+		void Write()
+		{
+			m_HasAccess = true;
+			(m_WriteComponents.push_back(TypeIndex<ComponentPoolBase>::Get<T>()), ...);
+		}
+
+	public:
+		/**
+		 * @brief Getting called every tick, systems that do not override it are not part of the tick phase
+		 *
+		 * @param registry The current registry where the system applies
+		 * @param currentTick The current tick that is executing
+		 */
+		virtual void OnTick(Registry& /* registry */, int /* currentTick */) {}
+
+		/**
+		 * @brief Getting called every update frame, systems that do not override it are not part of the update phase
+		 *
+		 * @param registry The current registry where the system applies
+		 * @param deltaTime The time difference between last update and current update
+		 */
+		virtual void OnUpdate(Registry& /* registry */, float /* deltaTime */) {}
+
+		/**
+		 * @brief Getting called every render frame, systems that do not override it are not part of the render phase
+		 *
+		 * @param registry The current registry where the system applies
+		 */
+		virtual void OnRender(Registry& /* registry */) {}
+	};
+
+	class World
+	{
+	private:
+		/* Registry for the current world, always the sparse set Registry, ArchetypeRegistry is not pluggable here */
+		Registry m_Registry;
+
+		/* Holds every system at the type id of its class, nullptr for classes that were not added */
+		std::vector<System*> m_Systems;
+
+		/* Systems of a phase and the dependency graph between them */
+		struct Schedule
+		{
+			/* Holds the systems that override the phase in the order they were added */
+			std::vector<System*> Systems;
+
+			/* Holds for every system the later systems that conflict with it and have to wait for it */
+			std::vector<std::vector<size_t>> Dependents;
+
+			/* Holds for every system the amount of earlier systems it has to wait for */
+			std::vector<size_t> DependencyCounts;
+
+			/* If the systems changed since the dependency graph was built */
+			bool IsDirty = true;
+		};
+
+		/* Holds the systems in the order they were added */
+		std::vector<System*> m_SystemOrder;
+
+		/* Holds the schedule of every phase */
+		Schedule m_Schedules[3];
+
+		/* Holds the render systems that conflict with no tick or update system, they run while the next frame ticks */
+		std::vector<System*> m_PipelinedSystems;
+
+		/* Mutex & Lock for the systems */
+		std::mutex m_SystemLock;
+
+		/* Holds the structural changes the systems recorded, played back after every phase */
+		CommandBuffer m_Commands;
+
+		/* The duration of a tick in seconds */
+		float m_TickDuration = 1.0f / 60.0f;
+
+		/* The maximum amount of ticks a frame runs to catch up, time beyond it is dropped */
+		size_t m_MaxTicksPerFrame = 5;
+
+		/* The minimum duration of a frame in seconds the run loop sleeps up to, zero if the frame rate is not limited */
+		float m_FrameDuration = 0.0f;
+
+		/* The time in seconds that passed and was not ticked yet */
+		float m_Accumulator = 0.0f;
+
+		/* The tick that is executed next */
+		int m_CurrentTick = 0;
+
+		/* If the pipelined render systems run on the thread pool while the next frame ticks and updates */
+		bool m_IsPipelined = false;
+
+		/* If the run loop keeps running */
+		std::atomic<bool> m_IsRunning = false;
+
+		/* Amount of pipelined render phases that are not done yet */
+		std::atomic<size_t> m_PendingRenders = 0;
+
+	#ifdef HYPERECS_PROFILE
+		/* Call of a system or a whole phase recorded for the trace */
+		struct TraceEvent
+		{
+			/* The name of the system */
+			std::string_view Name;
+
+			/* The phase the call belongs to */
+			SystemPhase Phase;
+
+			/* The thread the call ran on */
+			size_t Thread;
+
+			/* The start of the call in microseconds since the trace began */
+			double Start;
+
+			/* The duration of the call in microseconds */
+			double Duration;
+		};
+
+		/* Holds the timings of every whole phase */
+		SystemProfile m_FrameProfiles[3];
+
+		/* If calls are recorded for the trace */
+		std::atomic<bool> m_IsTracing = false;
+
+		/* The time the trace began at */
+		std::chrono::steady_clock::time_point m_TraceStart;
+
+		/* Holds the calls recorded for the trace */
+		std::vector<TraceEvent> m_TraceEvents;
+
+		/* Mutex & Lock for the trace */
+		std::mutex m_TraceLock;
+	#endif /* HYPERECS_PROFILE */
+
+	public:
+		World()
+		{
+		#ifdef HYPERECS_PROFILE
+			for (SystemProfile& profile : m_FrameProfiles)
+				profile.SetName("World");
+		#endif /* HYPERECS_PROFILE */
+		}
+
+		~World()
+		{
+			WaitForRender();
+			for (System* system : m_SystemOrder)
+				delete system;
+		}
+
+		World(const World&) = delete;
+		World& operator=(const World&) = delete;
+
+		/**
+		 * @brief Constructing an entity in the registry
+		 *
+		 * @return Returns an entity
+		 */
+		Entity Construct()
+		{
+			return m_Registry.Construct();
+		}
+
+		/**
+		 * @brief Constructing multiple entities in the registry at once
+		 *
+		 * @tparam OutputIt The type of the iterator the entities are written to
+		 * @param count The amount of entities that are getting constructed
+		 * @param output The iterator the entities are written to
+		 *
+		 * @return Returns the iterator past the last written entity
+		 */
+		template<class OutputIt>
+		OutputIt Construct(size_t count, OutputIt output)
+		{
+			return m_Registry.Construct(count, output);
+		}
+
+		/**
+		 * @brief Destroying an entity in the registry
+		 *
+		 * @param entity Entity that is getting destroyed
+		 */
+		void Destroy(Entity entity)
+		{
+			m_Registry.Destroy(entity);
+		}
+
+		/**
+		 * @brief Destroying multiple entities in the registry at once
+		 *
+		 * @param entities The entities that are getting destroyed, each at most once
+		 */
+		void Destroy(std::span<const Entity> entities)
+		{
+			m_Registry.Destroy(entities);
+		}
+
+		/**
+		 * @brief Check if an entity is alive, stale handles of destroyed entities are not
+		 *
+		 * @param entity The entity that is getting checked
+		 *
+		 * @return Returns if the entity was alive
+		 */
+		bool IsValid(Entity entity)
+		{
+			return m_Registry.IsValid(entity);
+		}
+
+		/**
+		 * @brief Adding component to an entity
+		 *
+		 * @tparam T The component class that is getting created
+		 * @tparam Args The arguments for the class
+		 * @param entity The corresponding entity that the component getting assigned to
+		 * @param args The arguments for the class
+		 *
+		 * @return Returns the created component
+		 */
+		template<class T, typename... Args>
+		constexpr ComponentReference<T> AddComponent(Entity entity, Args&&... args)
+		{
+			return m_Registry.AddComponent<T>(entity, std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief Adding a copy of a component to multiple entities at once
+		 *
+		 * @tparam T The component class that is getting created
+		 * @param entities The entities that the components getting assigned to, each at most once
+		 * @param component The component that is getting copied
+		 */
+		template<class T>
+		void AddComponents(std::span<const Entity> entities, const T& component)
+		{
+			m_Registry.AddComponents<T>(entities, component);
+		}
+
+		/**
+		 * @brief Moving components into multiple entities at once
+		 *
+		 * @tparam T The component class that is getting created
+		 * @param entities The entities that the components getting assigned to, each at most once
+		 * @param components The components that are moved, one for every entity
+		 */
+		template<class T>
+		void AddComponents(std::span<const Entity> entities, std::span<T> components)
+		{
+			m_Registry.AddComponents<T>(entities, components);
+		}
+
+		/**
+		 * @brief Removing component from an entity
+		 *
+		 * @tparam T The component class that is getting removed
+		 * @param entity The corresponding entity where component getting removed
+		 */
+		template<class T>
+		constexpr void RemoveComponent(Entity entity)
+		{
+			m_Registry.RemoveComponent<T>(entity);
+		}
+
+		/**
+		 * @brief Removing multiple components from an entity
+		 *
+		 * @tparam T The component classes that are getting removed
+		 * @param entity The corresponding entity where component getting removed
+		 */
+		template<class... T>
+		constexpr void RemoveMultipleComponent(Entity entity)
+		{
+			m_Registry.RemoveMultipleComponent<T...>(entity);
+		}
+
+		/**
+		 * @brief Getting component from an entity
+		 *
+		 * @tparam T The component class that is searched for
+		 * @param entity The corresponding entity that the component is assigned to
+		 *
+		 * @return Returns the corresponding component
+		 */
+		template<class T>
+		constexpr ComponentReference<T> GetComponent(Entity entity)
+		{
+			return m_Registry.GetComponent<T>(entity);
+		}
+
+		/**
+		 * @brief Getting component from an entity for writing, marking it as changed in the current tick
+		 *
+		 * @tparam T The component class that is searched for
+		 * @param entity The corresponding entity that the component is assigned to
+		 *
+		 * @return Returns the corresponding component
+		 */
+		template<class T>
+		ComponentReference<T> PatchComponent(Entity entity)
+		{
+			return m_Registry.PatchComponent<T>(entity);
+		}
+
+		/**
+		 * @brief Check if an entity has a component
+		 *
+		 * @tparam T The component class that is getting checked
+		 * @param entity The corresponding entity that the component is assigned to
+		 *
+		 * @return Returns if the component was found
+		 */
+		template<class T>
+		constexpr bool HasComponent(Entity entity)
+		{
+			return m_Registry.HasComponent<T>(entity);
+		}
+
+		/**
+		 * @brief Check if an entity has multiple components
+		 *
+		 * @tparam T The component classes that are getting checked
+		 * @param entity The corresponding entity that the component is assigned to
+		 *
+		 * @return Returns if the components were found
 		 */
 		template<class... T>
 		constexpr bool HasMultipleComponent(Entity entity)
 		{
-		#ifdef HYPERECS_MUTEX
-			std::unique_lock<std::mutex> entityLock(m_EntityLock);
-		#endif /* HYPERECS_MUTEX */
+			return m_Registry.HasMultipleComponent<T...>(entity);
+		}
 
-			if (m_Entities.find(entity) == m_Entities.end())
-			{
-				std::cerr << "[HyperECS] Entity does not exists!" << std::endl;
-				__debugbreak();
-			}
+		/**
+		 * @brief Registering an observer that is called after a component of a class was added, patched or removed
+		 *
+		 * @tparam T The component class that is observed
+		 * @param event The event that is observed
+		 * @param observer Function that is getting called with the registry and the entity after the event
+		 */
+		template<class T>
+		void Observe(ComponentEvent event, std::function<void(Registry&, Entity)> observer)
+		{
+			m_Registry.Observe<T>(event, std::move(observer));
+		}
 
-			bool shouldSkip = false;
-			auto lambda = [&]<typename C>() mutable
-			{
-				if (shouldSkip)
-					return;
+		/**
+		 * @brief Getting the current tick of the registry, it advances after every OnTick
+		 *
+		 * @return Returns the current tick
+		 */
+		uint64_t GetTick() const
+		{
+			return m_Registry.GetTick();
+		}
 
-			#ifdef HYPERECS_MUTEX
-				entityLock.unlock();
-			#endif /* HYPERECS_MUTEX */
+		/**
+		 * @brief Calling a function for every component of a class that was added in or after a tick
+		 *
+		 * @tparam T The class that is getting filtered
+		 * @tparam Function The type of the function, invocable with an entity and a reference to the component
+		 * @param sinceTick The first tick that is taken into account
+		 * @param function Function that is getting called for every entity whose component was added since the tick
+		 */
+		template<class T, class Function>
+		void EachAdded(uint64_t sinceTick, Function&& function)
+		{
+			m_Registry.EachAdded<T>(sinceTick, std::forward<Function>(function));
+		}
 
-				if (!HasComponent<C>(entity))
-					shouldSkip = true;
+		/**
+		 * @brief Calling a function for every component of a class that was added or patched in or after a tick
+		 *
+		 * @tparam T The class that is getting filtered
+		 * @tparam Function The type of the function, invocable with an entity and a reference to the component
+		 * @param sinceTick The first tick that is taken into account
+		 * @param function Function that is getting called for every entity whose component changed since the tick
+		 */
+		template<class T, class Function>
+		void EachChanged(uint64_t sinceTick, Function&& function)
+		{
+			m_Registry.EachChanged<T>(sinceTick, std::forward<Function>(function));
+		}
 
-			#ifdef HYPERECS_MUTEX
-				entityLock.lock();
-			#endif /* HYPERECS_MUTEX */
-			};
-			(lambda.template operator() < T > (), ...);
-			if (shouldSkip)
-				return false;
-			return true;
+		/**
+		 * @brief Recording the removed components of a class, so EachRemoved can visit them
+		 *
+		 * @tparam T The class whose removals are recorded
+		 */
+		template<class T>
+		void TrackRemoved()
+		{
+			m_Registry.TrackRemoved<T>();
 		}
 
 		/**
-		 * @brief Calling a function for every entity
+		 * @brief Calling a function for every component of a class that was removed in or after a tick
 		 *
-		 * @param function Function that is getting called for every entity
+		 * @tparam T The class that is getting filtered
+		 * @tparam Function The type of the function, invocable with an entity
+		 * @param sinceTick The first tick that is taken into account
+		 * @param function Function that is getting called for every entity whose component was removed since the tick
 		 */
-		void Each(const typename std::common_type<std::function<void(Entity)>>::type function)
+		template<class T, class Function>
+		void EachRemoved(uint64_t sinceTick, Function&& function)
 		{
-			for (auto& entity : m_Entities)
-				function(entity.first);
+			m_Registry.EachRemoved<T>(sinceTick, std::forward<Function>(function));
 		}
 
 		/**
-		 * @brief Calling a function for every entity with specified components
+		 * @brief Forgetting the recorded removals of a class before a tick
 		 *
-		 * @tparam T The classes that are getting filtered
-		 * @param function Function that is getting called for every entity that has the specified components
+		 * @tparam T The class whose removals are forgotten
+		 * @param beforeTick The first tick whose removals are kept
 		 */
-		template<class... T>
-		constexpr void Each(const typename std::common_type<std::function<void(Entity, T&...)>>::type function)
+		template<class T>
+		void TrimRemoved(uint64_t beforeTick)
 		{
-			for (const auto& entity : m_Entities)
-			{
-				bool shouldSkip = false;
-				auto lambda = [&]<typename C>() mutable
-				{
-					if (shouldSkip)
-						return;
-					if (!HasComponent<C>(entity.first))
-						shouldSkip = true;
-				};
-				(lambda.template operator() < T > (), ...);
-				if (shouldSkip)
-					continue;
-				function(entity.first, GetComponent<T>(entity.first)...);
-			}
+			m_Registry.TrimRemoved<T>(beforeTick);
 		}
 
 		/**
-		 * @brief Getting all entities
+		 * @brief Creating the pool of a component class up front, snapshots can only be loaded into registered classes
 		 *
-		 * @return Returns all entities
+		 * The class is registered for every world, so registering it once lets every world load it.
+		 *
+		 * @tparam T The component class of the pool
 		 */
-		std::vector<Entity> GetEntities() const
+		template<class T>
+		void Register()
 		{
-			std::vector<Entity> entities;
-			for (const auto& entity : m_Entities)
-				entities.push_back(entity.first);
-			return entities;
+			m_Registry.Register<T>();
 		}
 
 		/**
-		 * @brief Getting all entities with specified components
+		 * @brief Writing the entities, every serializable component pool and the hierarchy to a binary snapshot, systems are not part of it
 		 *
-		 * @tparam T The classes that are getting filtered
+		 * @param stream The stream that is written to
+		 */
+		void Save(std::ostream& stream)
+		{
+			m_Registry.Save(stream);
+		}
+
+		/**
+		 * @brief Replacing the entities, components and hierarchy with the ones of a binary snapshot
 		 *
-		 * @return Returns all entities with specified components
+		 * @param stream The stream that is read from
 		 */
-		template<class... T>
-		constexpr std::vector<Entity> GetEntities()
+		void Load(std::istream& stream)
 		{
-			std::vector<Entity> entities;
-			for (auto& entity : m_Entities)
-			{
-				bool shouldSkip = false;
-				auto lambda = [&]<typename C>() mutable {
-					if (shouldSkip)
-						return;
-					if (!HasComponent<C>(entity.first))
-						shouldSkip = true;
-				}; (lambda.template operator() < T > (), ...);
-				if (shouldSkip)
-					continue;
-				entities.push_back(entity.first);
-			}
-			return entities;
+			m_Registry.Load(stream);
 		}
-	};
 
-	class System
-	{
-	public:
 		/**
-		 * @brief Getting called every tick
+		 * @brief Writing the changes made in or after a tick to a binary delta, systems are not part of it
 		 *
-		 * @param registry The current registry where the system applies
-		 * @param currentTick The current tick that is executing
+		 * @param stream The stream that is written to
+		 * @param sinceTick The first tick whose changes are written
+		 */
+		void SaveDelta(std::ostream& stream, uint64_t sinceTick)
+		{
+			m_Registry.SaveDelta(stream, sinceTick);
+		}
+
+		/**
+		 * @brief Applying a binary delta, the world has to hold the state the delta was made against
+		 *
+		 * @param stream The stream that is read from
+		 */
+		void LoadDelta(std::istream& stream)
+		{
+			m_Registry.LoadDelta(stream);
+		}
+
+		/**
+		 * @brief Moving an entity and its components into another world, after the pipelined render systems of both are done
+		 *
+		 * @param entity The entity that is getting moved, it is destroyed in this world
+		 * @param destination The world the entity is moved to
+		 *
+		 * @return Returns the entity in the destination
+		 */
+		Entity Migrate(Entity entity, World& destination)
+		{
+			WaitForRender();
+			destination.WaitForRender();
+			return m_Registry.Migrate(entity, destination.m_Registry);
+		}
+
+		/**
+		 * @brief Moving multiple entities and their components into another world at once, after the pipelined render systems of both are done
+		 *
+		 * @tparam OutputIt The type of the iterator the entities in the destination are written to
+		 * @param entities The entities that are getting moved, each at most once, they are destroyed in this world
+		 * @param destination The world the entities are moved to
+		 * @param output The iterator the entities in the destination are written to, in the order of the moved entities
+		 *
+		 * @return Returns the iterator past the last written entity
+		 */
+		template<class OutputIt>
+		OutputIt Migrate(std::span<const Entity> entities, World& destination, OutputIt output)
+		{
+			WaitForRender();
+			destination.WaitForRender();
+			return m_Registry.Migrate(entities, destination.m_Registry, output);
+		}
+
+		/**
+		 * @brief Moving multiple entities and their components into another world at once, discarding their new handles
+		 *
+		 * @param entities The entities that are getting moved, each at most once, they are destroyed in this world
+		 * @param destination The world the entities are moved to
+		 */
+		void Migrate(std::span<const Entity> entities, World& destination)
+		{
+			WaitForRender();
+			destination.WaitForRender();
+			m_Registry.Migrate(entities, destination.m_Registry);
+		}
+
+		/**
+		 * @brief Moving every entity and its components of another world into this world, systems and resources are not moved
+		 *
+		 * @param source The world whose entities are moved, it has no entities afterwards
+		 */
+		void Merge(World& source)
+		{
+			WaitForRender();
+			source.WaitForRender();
+			m_Registry.Merge(source.m_Registry);
+		}
+
+		/**
+		 * @brief Getting the memory held by the entities, every component pool, every group and the hierarchy
+		 *
+		 * @return Returns the memory
+		 */
+		MemoryUsage GetMemoryUsage()
+		{
+			return m_Registry.GetMemoryUsage();
+		}
+
+		/**
+		 * @brief Writing the memory held by the entities, every component pool, every group and the hierarchy as JSON, the largest pools first
+		 *
+		 * @param path The path of the file that is written
+		 *
+		 * @return Returns if the file was written
+		 */
+		bool DumpMemoryUsage(const std::string& path)
+		{
+			return m_Registry.DumpMemoryUsage(path);
+		}
+
+		/**
+		 * @brief Calling a function for every entity
+		 *
+		 * @tparam Function The type of the function, invocable with an entity
+		 * @param function Function that is getting called for every entity
+		 */
+		template<class Function>
+		void Each(Function&& function)
+		{
+			m_Registry.Each(std::forward<Function>(function));
+		}
+
+		/**
+		 * @brief Calling a function for every entity with specified components
+		 *
+		 * @tparam T The classes that are getting filtered
+		 * @tparam Function The type of the function, invocable with an entity and references to the components
+		 * @param function Function that is getting called for every entity that has the specified components
 		 */
-		virtual void OnTick(Registry& registry, int currentTick) = 0;
+		template<class... T, class Function> requires (sizeof...(T) > 0)
+		constexpr void Each(Function&& function)
+		{
+			m_Registry.Each<T...>(std::forward<Function>(function));
+		}
 
 		/**
-		 * @brief Getting called every update frame
+		 * @brief Calling a function for every entity with specified components from multiple threads
 		 *
-		 * @param registry The current registry where the system applies
-		 * @param deltaTime The time difference between last update and current update
+		 * @tparam T The classes that are getting filtered
+		 * @tparam Function The type of the function, invocable with an entity and references to the components
+		 * @param function Function that is getting called for every entity that has the specified components
+		 * @param chunkSize The amount of entities per job, chosen from the thread count if zero
 		 */
-		virtual void OnUpdate(Registry& registry, float deltaTime) = 0;
+		template<class... T, class Function> requires (sizeof...(T) > 0)
+		void ParallelEach(Function&& function, size_t chunkSize = 0)
+		{
+			m_Registry.ParallelEach<T...>(std::forward<Function>(function), chunkSize);
+		}
 
 		/**
-		 * @brief Getting called every render frame
+		 * @brief Calling a function once with aligned spans over the fields of every entity with specified field components
 		 *
-		 * @param registry The current registry where the system applies
+		 * @tparam T The field component classes that are getting filtered
+		 * @tparam Function The type of the function, invocable with a span of the entities and FieldSpans of every component
+		 * @param function Function that is getting called with the spans
 		 */
-		virtual void OnRender(Registry& registry) = 0;
-	};
-
-	class World
-	{
-	private:
-		/* Registry for the current world */
-		Registry m_Registry;
-
-		/* Map that holds the typeid of a system as UUID and the corresponding system class data */
-		std::unordered_map<size_t, System*> m_Systems;
-
-		/* Mutex & Lock for the systems */
-		std::mutex m_SystemLock;
+		template<class... T, class Function> requires (sizeof...(T) > 0 && (FieldComponent<T> && ...))
+		void EachFields(Function&& function)
+		{
+			m_Registry.EachFields<T...>(std::forward<Function>(function));
+		}
 
-	public:
 		/**
-		 * @brief Constructing an entity in the registry
+		 * @brief Creating a query over the entities that match every term
 		 *
-		 * @return Returns an entity
+		 * @tparam Terms The terms of the query, component classes, Without<T>, Optional<T> and Changed<T>
+		 * @param sinceTick The tick changed terms compare against
+		 *
+		 * @return Returns the query
 		 */
-		Entity Construct()
+		template<class... Terms>
+		ComponentQuery<Terms...> Query(uint64_t sinceTick = 0)
 		{
-			return m_Registry.Construct();
+			return m_Registry.Query<Terms...>(sinceTick);
 		}
 
 		/**
-		 * @brief Destroying an entity in the registry
+		 * @brief Getting a range over every entity with specified components
 		 *
-		 * @param entity Entity that is getting destroyed
+		 * @tparam T The classes that are getting filtered
+		 *
+		 * @return Returns the range
 		 */
-		void Destroy(Entity entity)
+		template<class... T> requires (sizeof...(T) > 0)
+		ComponentView<T...> View()
 		{
-			m_Registry.Destroy(entity);
+			return m_Registry.View<T...>();
 		}
 
 		/**
-		 * @brief Adding component to an entity
+		 * @brief Constructing the resource of a class, a previous resource of the class is replaced
 		 *
-		 * @tparam T The component class that is getting created
+		 * @tparam T The resource class that is getting created
 		 * @tparam Args The arguments for the class
-		 * @param entity The corresponding entity that the component getting assigned to
 		 * @param args The arguments for the class
 		 *
-		 * @return Returns the created component
+		 * @return Returns the created resource
 		 */
 		template<class T, typename... Args>
-		constexpr T& AddComponent(Entity entity, Args&&... args)
+		T& SetResource(Args&&... args)
 		{
-			return m_Registry.AddComponent<T>(entity, args...);
+			return m_Registry.SetResource<T>(std::forward<Args>(args)...);
 		}
 
 		/**
-		 * @brief Removing component from an entity
+		 * @brief Removing the resource of a class
 		 *
-		 * @tparam T The component class that is getting removed
-		 * @param entity The corresponding entity where component getting removed
+		 * @tparam T The resource class that is getting removed
 		 */
 		template<class T>
-		constexpr void RemoveComponent(Entity entity)
+		void RemoveResource()
 		{
-			m_Registry.RemoveComponent<T>(entity);
+			m_Registry.RemoveResource<T>();
 		}
 
 		/**
-		 * @brief Removing multiple components from an entity
+		 * @brief Getting the resource of a class
 		 *
-		 * @tparam T The component classes that are getting removed
-		 * @param entity The corresponding entity where component getting removed
+		 * @tparam T The resource class that is searched for
+		 *
+		 * @return Returns the resource
 		 */
-		template<class... T>
-		constexpr void RemoveMultipleComponent(Entity entity)
+		template<class T>
+		T& GetResource()
 		{
-			m_Registry.RemoveMultipleComponent<T...>(entity);
+			return m_Registry.GetResource<T>();
 		}
 
 		/**
-		 * @brief Getting component from an entity
+		 * @brief Getting the resource of a class if it exists
 		 *
-		 * @tparam T The component class that is searched for
-		 * @param entity The corresponding entity that the component is assigned to
+		 * @tparam T The resource class that is searched for
 		 *
-		 * @return Returns the corresponding component
+		 * @return Returns the resource or nullptr if the class has no resource
 		 */
 		template<class T>
-		constexpr T& GetComponent(Entity entity)
+		T* TryGetResource()
 		{
-			return m_Registry.GetComponent<T>(entity);
+			return m_Registry.TryGetResource<T>();
 		}
 
 		/**
-		 * @brief Check if an entity has a component
+		 * @brief Check if a class has a resource
 		 *
-		 * @tparam T The component class that is getting checked
-		 * @param entity The corresponding entity that the component is assigned to
+		 * @tparam T The resource class that is getting checked
 		 *
-		 * @return Returns if the component was found
+		 * @return Returns if the resource was found
 		 */
 		template<class T>
-		constexpr bool HasComponent(Entity entity)
+		bool HasResource()
 		{
-			return m_Registry.HasComponent<T>(entity);
+			return m_Registry.HasResource<T>();
 		}
 
 		/**
-		 * @brief Check if an entity has multiple components
+		 * @brief Attaching an entity to a parent, the entity is detached from its previous parent
 		 *
-		 * @tparam T The component classes that are getting checked
-		 * @param entity The corresponding entity that the component is assigned to
+		 * @param child The entity that is getting attached
+		 * @param parent The new parent of the entity
+		 */
+		void SetParent(Entity child, Entity parent)
+		{
+			m_Registry.SetParent(child, parent);
+		}
+
+		/**
+		 * @brief Detaching an entity from its parent, the entity becomes a root
 		 *
-		 * @return Returns if the components were found
+		 * @param child The entity that is getting detached
 		 */
-		template<class... T>
-		constexpr bool HasMultipleComponent(Entity entity)
+		void RemoveParent(Entity child)
 		{
-			return m_Registry.HasMultipleComponent<T...>(entity);
+			m_Registry.RemoveParent(child);
 		}
 
 		/**
-		 * @brief Calling a function for every entity
+		 * @brief Getting the parent of an entity
 		 *
-		 * @param function Function that is getting called for every entity
+		 * @param child The entity whose parent is searched for
+		 *
+		 * @return Returns the parent or the null entity if the entity has no parent
 		 */
-		void Each(const typename std::common_type<std::function<void(Entity)>>::type function)
+		Entity GetParent(Entity child)
 		{
-			m_Registry.Each(function);
+			return m_Registry.GetParent(child);
 		}
 
 		/**
-		 * @brief Calling a function for every entity with specified components
+		 * @brief Calling a function for every child of an entity
 		 *
-		 * @tparam T The classes that are getting filtered
-		 * @param function Function that is getting called for every entity that has the specified components
+		 * @tparam Function The type of the function, invocable with an entity
+		 * @param parent The entity whose children are visited
+		 * @param function Function that is getting called for every child
 		 */
-		template<class... T>
-		constexpr void Each(const typename std::common_type<std::function<void(Entity, T&...)>>::type function)
+		template<class Function>
+		void EachChild(Entity parent, Function&& function)
+		{
+			m_Registry.EachChild(parent, std::forward<Function>(function));
+		}
+
+		/**
+		 * @brief Calling a function for every entity with a parent or children, parents before their children
+		 *
+		 * @tparam Function The type of the function, invocable with an entity and its parent, the null entity for roots
+		 * @param function Function that is getting called for every entity in the hierarchy
+		 */
+		template<class Function>
+		void EachHierarchy(Function&& function)
+		{
+			m_Registry.EachHierarchy(std::forward<Function>(function));
+		}
+
+		/**
+		 * @brief Calling a function for every entity with a parent or children from multiple threads, one depth after another
+		 *
+		 * @tparam Function The type of the function, invocable with an entity and its parent, the null entity for roots
+		 * @param function Function that is getting called for every entity in the hierarchy
+		 * @param chunkSize The amount of entities per job, chosen from the thread count if zero
+		 */
+		template<class Function>
+		void ParallelEachHierarchy(Function&& function, size_t chunkSize = 0)
 		{
-			m_Registry.Each<T...>(function);
+			m_Registry.ParallelEachHierarchy(std::forward<Function>(function), chunkSize);
 		}
 
 		/**
@@ -674,7 +7067,7 @@ namespace HyperECS
 		 *
 		 * @return Returns all entities with specified components
 		 */
-		template<class... T>
+		template<class... T> requires (sizeof...(T) > 0)
 		constexpr std::vector<Entity> GetEntities()
 		{
 			return m_Registry.GetEntities<T...>();
@@ -698,12 +7091,34 @@ namespace HyperECS
 				__debugbreak();
 			}
 
+			WaitForRender();
+
 		#ifdef HYPERECS_MUTEX
 			std::unique_lock<std::mutex> systemLock(m_SystemLock);
 		#endif /* HYPERECS_MUTEX */
 
-			m_Systems[typeid(T).hash_code()] = new T(std::forward<Args>(args)...);
-			return *static_cast<T*>(m_Systems.at(typeid(T).hash_code()));
+			size_t systemId = TypeIndex<System>::Get<T>();
+			if (systemId >= m_Systems.size())
+				m_Systems.resize(systemId + 1);
+
+			T* system = new T(std::forward<Args>(args)...);
+			m_Systems[systemId] = system;
+
+		#ifdef HYPERECS_PROFILE
+			for (SystemPhase phase : { SystemPhase::Tick, SystemPhase::Update, SystemPhase::Render })
+				system->GetProfile(phase).SetName(GetTypeName<T>());
+		#endif /* HYPERECS_PROFILE */
+			m_SystemOrder.push_back(system);
+			if constexpr (!std::is_same_v<decltype(&T::OnTick), decltype(&System::OnTick)>)
+				m_Schedules[static_cast<size_t>(SystemPhase::Tick)].Systems.push_back(system);
+			if constexpr (!std::is_same_v<decltype(&T::OnUpdate), decltype(&System::OnUpdate)>)
+				m_Schedules[static_cast<size_t>(SystemPhase::Update)].Systems.push_back(system);
+			if constexpr (!std::is_same_v<decltype(&T::OnRender), decltype(&System::OnRender)>)
+				m_Schedules[static_cast<size_t>(SystemPhase::Render)].Systems.push_back(system);
+
+			for (Schedule& schedule : m_Schedules)
+				schedule.IsDirty = true;
+			return *system;
 		}
 
 		/**
@@ -720,11 +7135,21 @@ namespace HyperECS
 				__debugbreak();
 			}
 
+			WaitForRender();
+
 		#ifdef HYPERECS_MUTEX
 			std::unique_lock<std::mutex> systemLock(m_SystemLock);
 		#endif /* HYPERECS_MUTEX */
 
-			m_Systems.erase(typeid(T).hash_code());
+			System*& system = m_Systems[TypeIndex<System>::Get<T>()];
+			m_SystemOrder.erase(std::find(m_SystemOrder.begin(), m_SystemOrder.end(), system));
+			for (Schedule& schedule : m_Schedules)
+			{
+				std::erase(schedule.Systems, system);
+				schedule.IsDirty = true;
+			}
+			delete system;
+			system = nullptr;
 		}
 
 		/**
@@ -772,7 +7197,7 @@ namespace HyperECS
 			std::unique_lock<std::mutex> systemLock(m_SystemLock);
 		#endif /* HYPERECS_MUTEX */
 
-			return *static_cast<T*>(m_Systems.at(typeid(T).hash_code()));
+			return *static_cast<T*>(m_Systems[TypeIndex<System>::Get<T>()]);
 		}
 
 		/**
@@ -789,7 +7214,8 @@ namespace HyperECS
 			std::unique_lock<std::mutex> systemLock(m_SystemLock);
 		#endif /* HYPERECS_MUTEX */
 
-			return m_Systems.find(typeid(T).hash_code()) != m_Systems.end();
+			size_t systemId = TypeIndex<System>::Get<T>();
+			return systemId < m_Systems.size() && m_Systems[systemId] != nullptr;
 		}
 
 		/**
@@ -830,45 +7256,422 @@ namespace HyperECS
 		/**
 		 * @brief Getting all systems
 		 *
-		 * @return Returns all systems
+		 * @return Returns all systems in the order they were added
 		 */
 		std::vector<System*> GetSystems()
 		{
-			std::vector<System*> systems;
-			for (auto& system : m_Systems)
-				systems.push_back(system.second);
-			return systems;
+			return m_SystemOrder;
+		}
+
+		/**
+		 * @brief Getting the command buffer of the world
+		 *
+		 * Changes recorded into it are applied after the systems of the current OnTick, OnUpdate or OnRender call ran.
+		 *
+		 * @return Returns the command buffer
+		 */
+		CommandBuffer& GetCommandBuffer()
+		{
+			return m_Commands;
 		}
 
 		/**
-		 * @brief Calling from every system the OnTick function
+		 * @brief Calling from every system the OnTick function, running systems without conflicting access concurrently
+		 *
+		 * Only systems that override OnTick are called. Afterwards the recorded commands are applied and the change
+		 * tracking of the registry advances to the next tick.
 		 *
 		 * @param currentTick The current tick that is executing
 		 */
 		void OnTick(int currentTick)
 		{
-			for (auto& system : m_Systems)
-				system.second->OnTick(m_Registry, currentTick);
+		#ifdef HYPERECS_PROFILE
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		#endif /* HYPERECS_PROFILE */
+
+			RunSystems(m_Schedules[static_cast<size_t>(SystemPhase::Tick)], [&](System& system) { InvokeSystem(system, SystemPhase::Tick, [&]() { system.OnTick(m_Registry, currentTick); }); });
+			WaitForRender();
+			m_Commands.Playback(m_Registry);
+			m_Registry.AdvanceTick();
+
+		#ifdef HYPERECS_PROFILE
+			RecordCall(m_FrameProfiles[static_cast<size_t>(SystemPhase::Tick)], SystemPhase::Tick, start, 0);
+		#endif /* HYPERECS_PROFILE */
 		}
 
 		/**
-		 * @brief Calling from every system the OnUpdate function
+		 * @brief Calling from every system the OnUpdate function, running systems without conflicting access concurrently
+		 *
+		 * Only systems that override OnUpdate are called.
 		 *
 		 * @param deltaTime The time difference between last update and current update
 		 */
 		void OnUpdate(float deltaTime)
 		{
-			for (auto& system : m_Systems)
-				system.second->OnUpdate(m_Registry, deltaTime);
+		#ifdef HYPERECS_PROFILE
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		#endif /* HYPERECS_PROFILE */
+
+			RunSystems(m_Schedules[static_cast<size_t>(SystemPhase::Update)], [&](System& system) { InvokeSystem(system, SystemPhase::Update, [&]() { system.OnUpdate(m_Registry, deltaTime); }); });
+			WaitForRender();
+			m_Commands.Playback(m_Registry);
+
+		#ifdef HYPERECS_PROFILE
+			RecordCall(m_FrameProfiles[static_cast<size_t>(SystemPhase::Update)], SystemPhase::Update, start, 0);
+		#endif /* HYPERECS_PROFILE */
 		}
 
 		/**
-		 * @brief Calling from every system the OnRender function
+		 * @brief Calling from every system the OnRender function in the order the systems were added on the calling thread
+		 *
+		 * Only systems that override OnRender are called. With pipelining the render systems that conflict with no tick
+		 * or update system run on the thread pool instead and overlap the next frame, the other ones run before on the
+		 * calling thread. The first render after the systems changed is never pipelined.
 		 */
 		void OnRender()
 		{
-			for (auto& system : m_Systems)
-				system.second->OnRender(m_Registry);
+		#ifdef HYPERECS_PROFILE
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		#endif /* HYPERECS_PROFILE */
+
+			Schedule& schedule = m_Schedules[static_cast<size_t>(SystemPhase::Render)];
+			bool isPipelined = m_IsPipelined && !schedule.IsDirty;
+			if (schedule.IsDirty)
+			{
+				BuildPipeline();
+				schedule.IsDirty = false;
+			}
+
+			WaitForRender();
+			for (System* system : schedule.Systems)
+				if (!isPipelined || std::find(m_PipelinedSystems.begin(), m_PipelinedSystems.end(), system) == m_PipelinedSystems.end())
+					InvokeSystem(*system, SystemPhase::Render, [&]() { system->OnRender(m_Registry); });
+			m_Commands.Playback(m_Registry);
+
+			if (isPipelined && !m_PipelinedSystems.empty())
+			{
+				m_PendingRenders.store(1, std::memory_order_relaxed);
+				ThreadPool::GetDefault().Submit([this]()
+				{
+					for (System* system : m_PipelinedSystems)
+						InvokeSystem(*system, SystemPhase::Render, [&]() { system->OnRender(m_Registry); });
+					m_PendingRenders.store(0, std::memory_order_release);
+				});
+			}
+
+		#ifdef HYPERECS_PROFILE
+			RecordCall(m_FrameProfiles[static_cast<size_t>(SystemPhase::Render)], SystemPhase::Render, start, 0);
+		#endif /* HYPERECS_PROFILE */
+		}
+
+		/**
+		 * @brief Setting the rate the run loop ticks with
+		 *
+		 * @param ticksPerSecond The amount of ticks per second
+		 */
+		void SetTickRate(float ticksPerSecond)
+		{
+			m_TickDuration = 1.0f / ticksPerSecond;
+		}
+
+		/**
+		 * @brief Setting the maximum amount of ticks a frame runs to catch up, time beyond it is dropped
+		 *
+		 * @param maxTicks The maximum amount of ticks per frame
+		 */
+		void SetMaxTicksPerFrame(size_t maxTicks)
+		{
+			m_MaxTicksPerFrame = maxTicks;
+		}
+
+		/**
+		 * @brief Setting the maximum amount of frames per second the run loop runs
+		 *
+		 * Without a limit the run loop sleeps until the next tick is due after every frame.
+		 *
+		 * @param framesPerSecond The maximum amount of frames per second, zero to not limit the frame rate
+		 */
+		void SetMaxFrameRate(float framesPerSecond)
+		{
+			m_FrameDuration = framesPerSecond > 0.0f ? 1.0f / framesPerSecond : 0.0f;
+		}
+
+		/**
+		 * @brief Setting if render systems that conflict with no tick or update system overlap the next frame
+		 *
+		 * Structural changes from outside of the systems have to wait for the render with WaitForRender.
+		 *
+		 * @param isPipelined If the render systems are pipelined
+		 */
+		void SetPipelining(bool isPipelined)
+		{
+			WaitForRender();
+			m_IsPipelined = isPipelined;
+		}
+
+		/**
+		 * @brief Getting how far the time went past the last tick, for interpolating between ticks while rendering
+		 *
+		 * @return Returns the fraction of a tick between zero and one
+		 */
+		float GetInterpolation() const
+		{
+			return m_Accumulator / m_TickDuration;
+		}
+
+		/**
+		 * @brief Running one frame, the ticks that are due with the fixed tick rate followed by an update and a render
+		 *
+		 * @param deltaTime The time in seconds that passed since the last frame
+		 *
+		 * @return Returns the amount of ticks that were executed
+		 */
+		size_t Step(float deltaTime)
+		{
+			m_Accumulator += deltaTime;
+
+			size_t ticks = 0;
+			while (m_Accumulator >= m_TickDuration && ticks < m_MaxTicksPerFrame)
+			{
+				OnTick(m_CurrentTick++);
+				m_Accumulator -= m_TickDuration;
+				ticks++;
+			}
+
+			if (m_Accumulator >= m_TickDuration)
+				m_Accumulator = std::fmod(m_Accumulator, m_TickDuration);
+
+			OnUpdate(deltaTime);
+			OnRender();
+			return ticks;
+		}
+
+		/**
+		 * @brief Running frames with the measured time between them until Stop is called
+		 *
+		 * Between the frames the loop sleeps until the frame deadline of SetMaxFrameRate or the next tick instead of spinning.
+		 */
+		void Run()
+		{
+			m_IsRunning.store(true, std::memory_order_relaxed);
+
+			std::chrono::steady_clock::time_point previous = std::chrono::steady_clock::now();
+			while (m_IsRunning.load(std::memory_order_relaxed))
+			{
+				std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+				Step(std::chrono::duration<float>(now - previous).count());
+				previous = now;
+
+				/* Sleeping until the frame deadline, or until the next tick is due when the frame rate is not limited */
+				float wait = m_FrameDuration > 0.0f ? m_FrameDuration : m_TickDuration - m_Accumulator;
+				std::chrono::steady_clock::time_point deadline = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(wait));
+				if (m_IsRunning.load(std::memory_order_relaxed) && deadline > std::chrono::steady_clock::now())
+					std::this_thread::sleep_until(deadline);
+			}
+
+			WaitForRender();
+		}
+
+		/**
+		 * @brief Stopping the run loop after the current frame, can be called from systems and other threads
+		 */
+		void Stop()
+		{
+			m_IsRunning.store(false, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Waiting until the pipelined render systems of the last frame are done
+		 */
+		void WaitForRender()
+		{
+			if (m_PendingRenders.load(std::memory_order_acquire) != 0)
+				ThreadPool::GetDefault().Wait(m_PendingRenders);
+		}
+
+	#ifdef HYPERECS_PROFILE
+		/**
+		 * @brief Getting the timings of a whole phase, including the playback of the command buffer
+		 *
+		 * @param phase The phase
+		 *
+		 * @return Returns the timings
+		 */
+		const SystemProfile& GetFrameProfile(SystemPhase phase) const
+		{
+			return m_FrameProfiles[static_cast<size_t>(phase)];
+		}
+
+		/**
+		 * @brief Starting to record every system call and phase for a trace, discarding a previous trace
+		 */
+		void BeginTrace()
+		{
+			std::unique_lock<std::mutex> traceLock(m_TraceLock);
+			m_TraceEvents.clear();
+			m_TraceStart = std::chrono::steady_clock::now();
+			m_IsTracing.store(true, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Stopping the trace and writing it as Chrome trace JSON, viewable in chrome://tracing or Perfetto
+		 *
+		 * @param path The path of the file that is written
+		 *
+		 * @return Returns if the file was written
+		 */
+		bool EndTrace(const std::string& path)
+		{
+			std::unique_lock<std::mutex> traceLock(m_TraceLock);
+			m_IsTracing.store(false, std::memory_order_relaxed);
+
+			std::ofstream file(path);
+			if (!file)
+				return false;
+
+			static constexpr const char* PhaseNames[] = { "OnTick", "OnUpdate", "OnRender" };
+			file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+			for (size_t index = 0; index < m_TraceEvents.size(); index++)
+			{
+				const TraceEvent& event = m_TraceEvents[index];
+				file << (index == 0 ? "" : ",") << "\n{\"name\":";
+				WriteJsonString(file, event.Name);
+				file << ",\"cat\":\"" << PhaseNames[static_cast<size_t>(event.Phase)] << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.Thread << ",\"ts\":" << event.Start << ",\"dur\":" << event.Duration << "}";
+			}
+			file << "\n]}\n";
+			m_TraceEvents.clear();
+			return static_cast<bool>(file);
+		}
+	#endif /* HYPERECS_PROFILE */
+
+	private:
+		/**
+		 * @brief Calling a phase of a system, measuring it with HYPERECS_PROFILE
+		 *
+		 * @tparam Function The type of the function
+		 * @param system The system that is called
+		 * @param phase The phase that is called
+		 * @param function Function that calls the phase of the system
+		 */
+		template<class Function>
+		void InvokeSystem([[maybe_unused]] System& system, [[maybe_unused]] SystemPhase phase, Function&& function)
+		{
+		#ifdef HYPERECS_PROFILE
+			uint64_t entityCount = 0;
+			uint64_t* previousCounter = SystemProfile::SetEntityCounter(&entityCount);
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			function();
+			SystemProfile::SetEntityCounter(previousCounter);
+			RecordCall(system.GetProfile(phase), phase, start, entityCount);
+		#else
+			function();
+		#endif /* HYPERECS_PROFILE */
+		}
+
+	#ifdef HYPERECS_PROFILE
+		/**
+		 * @brief Recording a finished call in its profile and in the trace
+		 *
+		 * @param profile The profile of the call
+		 * @param phase The phase of the call
+		 * @param start The time the call started at
+		 * @param entityCount The amount of entities the call iterated
+		 */
+		void RecordCall(SystemProfile& profile, SystemPhase phase, std::chrono::steady_clock::time_point start, uint64_t entityCount)
+		{
+			std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+			profile.Record(std::chrono::duration<double, std::milli>(end - start).count(), entityCount);
+			if (!m_IsTracing.load(std::memory_order_relaxed))
+				return;
+
+			static std::atomic<size_t> s_NextThread = 0;
+			static thread_local size_t s_Thread = s_NextThread.fetch_add(1, std::memory_order_relaxed);
+
+			std::unique_lock<std::mutex> traceLock(m_TraceLock);
+			m_TraceEvents.push_back({ profile.GetName(), phase, s_Thread, std::chrono::duration<double, std::micro>(start - m_TraceStart).count(), std::chrono::duration<double, std::micro>(end - start).count() });
+		}
+	#endif /* HYPERECS_PROFILE */
+
+		/**
+		 * @brief Building the dependency graph of a phase, every system waits for the earlier systems it conflicts with
+		 *
+		 * @param schedule The schedule of the phase
+		 */
+		void BuildSchedule(Schedule& schedule)
+		{
+			const std::vector<System*>& systems = schedule.Systems;
+			schedule.Dependents.assign(systems.size(), {});
+			schedule.DependencyCounts.assign(systems.size(), 0);
+			for (size_t later = 0; later < systems.size(); later++)
+				for (size_t earlier = 0; earlier < later; earlier++)
+					if (systems[earlier]->ConflictsWith(*systems[later]))
+					{
+						schedule.Dependents[earlier].push_back(later);
+						schedule.DependencyCounts[later]++;
+					}
+		}
+
+		/**
+		 * @brief Collecting the render systems that take part in no other phase and conflict with no tick or update system
+		 */
+		void BuildPipeline()
+		{
+			const std::vector<System*>& tickSystems = m_Schedules[static_cast<size_t>(SystemPhase::Tick)].Systems;
+			const std::vector<System*>& updateSystems = m_Schedules[static_cast<size_t>(SystemPhase::Update)].Systems;
+
+			m_PipelinedSystems.clear();
+			for (System* system : m_Schedules[static_cast<size_t>(SystemPhase::Render)].Systems)
+			{
+				auto conflicts = [system](System* other) { return other == system || other->ConflictsWith(*system); };
+				if (std::none_of(tickSystems.begin(), tickSystems.end(), conflicts) && std::none_of(updateSystems.begin(), updateSystems.end(), conflicts))
+					m_PipelinedSystems.push_back(system);
+			}
+		}
+
+		/**
+		 * @brief Running a phase of every system along the dependency graph on the shared thread pool
+		 *
+		 * The first run after the systems changed is serial, so the pools and groups the systems query are
+		 * created before any of them run concurrently.
+		 *
+		 * @tparam Function The type of the function, invocable with a system
+		 * @param schedule The schedule of the phase
+		 * @param function Function that runs the phase of a system
+		 */
+		template<class Function>
+		void RunSystems(Schedule& schedule, Function&& function)
+		{
+			const std::vector<System*>& systems = schedule.Systems;
+			if (schedule.IsDirty)
+			{
+				BuildSchedule(schedule);
+				schedule.IsDirty = false;
+
+				for (System* system : systems)
+					function(*system);
+				return;
+			}
+
+			std::vector<std::atomic<size_t>> waiting(systems.size());
+			for (size_t index = 0; index < systems.size(); index++)
+				waiting[index].store(schedule.DependencyCounts[index], std::memory_order_relaxed);
+
+			ThreadPool& threadPool = ThreadPool::GetDefault();
+			std::atomic<size_t> remaining = systems.size();
+			std::function<void(size_t)> run = [&](size_t index)
+			{
+				function(*systems[index]);
+				for (size_t dependent : schedule.Dependents[index])
+					if (waiting[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+						threadPool.Submit([&run, dependent]() { run(dependent); });
+				remaining.fetch_sub(1, std::memory_order_release);
+			};
+
+			for (size_t index = 0; index < systems.size(); index++)
+				if (schedule.DependencyCounts[index] == 0)
+					threadPool.Submit([&run, index]() { run(index); });
+
+			threadPool.Wait(remaining);
 		}
 	};
 }
\ No newline at end of file
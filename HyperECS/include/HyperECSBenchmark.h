@@ -0,0 +1,262 @@
+#pragma once
+
+#include "HyperECS.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace HyperECS
+{
+	/* Micro benchmarks of the registry operations, every result is written as one JSON object per line */
+	class Benchmark
+	{
+	private:
+		/* Component that is iterated alone */
+		struct Position
+		{
+			float X, Y, Z;
+		};
+
+		/* Component that is iterated together with the position */
+		struct Velocity
+		{
+			float X, Y, Z;
+		};
+
+		/* The stream the results are written to */
+		std::ostream& m_Output;
+
+		/* Amount of runs per benchmark, the fastest and the median run are reported */
+		size_t m_Repetitions;
+
+		/* Sum of the visited components, keeps the compiler from removing the loops */
+		volatile float m_Sink = 0.0f;
+
+	public:
+		/**
+		 * @brief Creating the benchmarks
+		 *
+		 * @param output The stream the results are written to
+		 * @param repetitions Amount of runs per benchmark
+		 */
+		explicit Benchmark(std::ostream& output = std::cout, size_t repetitions = 5)
+			: m_Output(output), m_Repetitions(std::max<size_t>(1, repetitions)) {}
+
+		/**
+		 * @brief Running every benchmark for every entity count
+		 *
+		 * @param entityCounts The amounts of entities the benchmarks run with
+		 */
+		void Run(std::initializer_list<size_t> entityCounts = { 10000, 100000, 1000000 })
+		{
+			for (size_t entityCount : entityCounts)
+				Run(entityCount);
+		}
+
+		/**
+		 * @brief Running every benchmark for an entity count, first on the sparse set registry and then on the archetype registry
+		 *
+		 * @param entityCount The amount of entities the benchmarks run with
+		 */
+		void Run(size_t entityCount)
+		{
+			Run<Registry>("Registry", entityCount);
+			Run<ArchetypeRegistry>("ArchetypeRegistry", entityCount);
+		}
+
+	private:
+		/**
+		 * @brief Running every benchmark a registry class supports for an entity count
+		 *
+		 * The bulk operations and ParallelEach only exist on the sparse set registry, the archetype registry runs the other benchmarks.
+		 *
+		 * @tparam RegistryType The registry class the benchmarks run on
+		 * @param registryName The name of the registry class in the results
+		 * @param entityCount The amount of entities the benchmarks run with
+		 */
+		template<class RegistryType>
+		void Run(const char* registryName, size_t entityCount)
+		{
+			constexpr bool IsSparseSet = std::is_same_v<RegistryType, Registry>;
+
+			Measure<RegistryType>("Construct", registryName, entityCount, [](RegistryType&, std::vector<Entity>&) {}, [&](RegistryType& registry, std::vector<Entity>&)
+			{
+				for (size_t index = 0; index < entityCount; index++)
+					registry.Construct();
+			});
+
+			if constexpr (IsSparseSet)
+			{
+				Measure<RegistryType>("ConstructBulk", registryName, entityCount, [&](RegistryType&, std::vector<Entity>& entities) { entities.reserve(entityCount); }, [&](RegistryType& registry, std::vector<Entity>& entities)
+				{
+					registry.Construct(entityCount, std::back_inserter(entities));
+				});
+			}
+
+			Measure<RegistryType>("Destroy", registryName, entityCount, [&](RegistryType& registry, std::vector<Entity>& entities) { Populate<Position>(entityCount, registry, entities); }, [](RegistryType& registry, std::vector<Entity>& entities)
+			{
+				for (Entity entity : entities)
+					registry.Destroy(entity);
+			});
+
+			if constexpr (IsSparseSet)
+			{
+				Measure<RegistryType>("DestroyBulk", registryName, entityCount, [&](RegistryType& registry, std::vector<Entity>& entities) { Populate<Position>(entityCount, registry, entities); }, [](RegistryType& registry, std::vector<Entity>& entities)
+				{
+					registry.Destroy(entities);
+				});
+			}
+
+			Measure<RegistryType>("AddComponent", registryName, entityCount, [&](RegistryType& registry, std::vector<Entity>& entities) { Populate<>(entityCount, registry, entities); }, [](RegistryType& registry, std::vector<Entity>& entities)
+			{
+				for (Entity entity : entities)
+					registry.template AddComponent<Position>(entity, 1.0f, 2.0f, 3.0f);
+			});
+
+			if constexpr (IsSparseSet)
+			{
+				Measure<RegistryType>("AddComponents", registryName, entityCount, [&](RegistryType& registry, std::vector<Entity>& entities) { Populate<>(entityCount, registry, entities); }, [](RegistryType& registry, std::vector<Entity>& entities)
+				{
+					registry.template AddComponents<Position>(entities, Position{ 1.0f, 2.0f, 3.0f });
+				});
+			}
+
+			Measure<RegistryType>("RemoveComponent", registryName, entityCount, [&](RegistryType& registry, std::vector<Entity>& entities) { Populate<Position>(entityCount, registry, entities); }, [](RegistryType& registry, std::vector<Entity>& entities)
+			{
+				for (Entity entity : entities)
+					registry.template RemoveComponent<Position>(entity);
+			});
+
+			Measure<RegistryType>("EachSingle", registryName, entityCount, [&](RegistryType& registry, std::vector<Entity>& entities) { Populate<Position, Velocity>(entityCount, registry, entities); }, [this](RegistryType& registry, std::vector<Entity>&)
+			{
+				float sum = 0.0f;
+				registry.template Each<Position>([&](Entity, Position& position) { sum += position.X; });
+				m_Sink = sum;
+			});
+
+			auto eachMultiple = [this](RegistryType& registry, std::vector<Entity>&)
+			{
+				float sum = 0.0f;
+				registry.template Each<Position, Velocity>([&](Entity, Position& position, Velocity& velocity) { sum += position.X + velocity.X; });
+				m_Sink = sum;
+			};
+			Measure<RegistryType>("EachMultiple", registryName, entityCount, [&](RegistryType& registry, std::vector<Entity>& entities) { PopulateWarm(entityCount, registry, entities, eachMultiple); }, eachMultiple);
+
+			if constexpr (IsSparseSet)
+			{
+				auto parallelEachMultiple = [](RegistryType& registry, std::vector<Entity>&)
+				{
+					registry.template ParallelEach<Position, Velocity>([](Entity, Position& position, Velocity& velocity) { position.X += velocity.X; });
+				};
+				Measure<RegistryType>("ParallelEachMultiple", registryName, entityCount, [&](RegistryType& registry, std::vector<Entity>& entities) { PopulateWarm(entityCount, registry, entities, parallelEachMultiple); }, parallelEachMultiple);
+			}
+
+			auto getEntities = [this](RegistryType& registry, std::vector<Entity>&)
+			{
+				m_Sink = static_cast<float>(registry.template GetEntities<Position, Velocity>().size());
+			};
+			Measure<RegistryType>("GetEntities", registryName, entityCount, [&](RegistryType& registry, std::vector<Entity>& entities) { PopulateWarm(entityCount, registry, entities, getEntities); }, getEntities);
+
+			Measure<RegistryType>("GetComponentRandom", registryName, entityCount, [&](RegistryType& registry, std::vector<Entity>& entities)
+			{
+				Populate<Position>(entityCount, registry, entities);
+				std::shuffle(entities.begin(), entities.end(), std::mt19937(entityCount));
+			}, [this](RegistryType& registry, std::vector<Entity>& entities)
+			{
+				float sum = 0.0f;
+				for (Entity entity : entities)
+					sum += registry.template GetComponent<Position>(entity).X;
+				m_Sink = sum;
+			});
+		}
+
+		/**
+		 * @brief Constructing entities with components
+		 *
+		 * @tparam T The component classes every entity gets
+		 * @tparam RegistryType The registry class the entities are constructed in
+		 * @param entityCount The amount of entities
+		 * @param registry The registry the entities are constructed in
+		 * @param entities The constructed entities
+		 */
+		template<class... T, class RegistryType>
+		static void Populate(size_t entityCount, RegistryType& registry, std::vector<Entity>& entities)
+		{
+			if constexpr (std::is_same_v<RegistryType, Registry>)
+			{
+				registry.Construct(entityCount, std::back_inserter(entities));
+				(registry.template AddComponents<T>(entities, T{ 1.0f, 2.0f, 3.0f }), ...);
+			}
+			else
+			{
+				entities.reserve(entityCount);
+				for (size_t index = 0; index < entityCount; index++)
+				{
+					Entity entity = registry.Construct();
+					(registry.template AddComponent<T>(entity, 1.0f, 2.0f, 3.0f), ...);
+					entities.push_back(entity);
+				}
+			}
+		}
+
+		/**
+		 * @brief Constructing entities with a position and a velocity and running a benchmark once untimed
+		 *
+		 * The first iteration of multiple components builds the group of the signature, warming it up keeps that out of the measurement.
+		 *
+		 * @tparam RegistryType The registry class the entities are constructed in
+		 * @tparam Function The type of the benchmark, invocable with the registry and the entities
+		 * @param entityCount The amount of entities
+		 * @param registry The registry the entities are constructed in
+		 * @param entities The constructed entities
+		 * @param function The benchmark that is run once
+		 */
+		template<class RegistryType, class Function>
+		static void PopulateWarm(size_t entityCount, RegistryType& registry, std::vector<Entity>& entities, Function& function)
+		{
+			Populate<Position, Velocity>(entityCount, registry, entities);
+			function(registry, entities);
+		}
+
+		/**
+		 * @brief Timing a benchmark on a fresh registry per run and writing the result
+		 *
+		 * @tparam RegistryType The registry class the benchmark runs on
+		 * @tparam Setup The type of the setup, invocable with the registry and the entities
+		 * @tparam Function The type of the benchmark, invocable with the registry and the entities
+		 * @param name The name of the benchmark
+		 * @param registryName The name of the registry class
+		 * @param entityCount The amount of entities the benchmark runs with
+		 * @param setup Function that prepares the registry, it is not timed
+		 * @param function Function that is timed
+		 */
+		template<class RegistryType, class Setup, class Function>
+		void Measure(const char* name, const char* registryName, size_t entityCount, Setup&& setup, Function&& function)
+		{
+			std::vector<double> durations;
+			for (size_t repetition = 0; repetition < m_Repetitions; repetition++)
+			{
+				std::unique_ptr<RegistryType> registry = std::make_unique<RegistryType>();
+				std::vector<Entity> entities;
+				setup(*registry, entities);
+
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				function(*registry, entities);
+				std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+				durations.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+			}
+
+			std::sort(durations.begin(), durations.end());
+			double median = durations[durations.size() / 2];
+			m_Output << "{\"benchmark\":\"" << name << "\",\"registry\":\"" << registryName << "\",\"entities\":" << entityCount << ",\"repetitions\":" << m_Repetitions
+				<< ",\"min_ns\":" << durations.front() << ",\"median_ns\":" << median << ",\"median_ns_per_entity\":" << median / static_cast<double>(std::max<size_t>(1, entityCount)) << "}" << std::endl;
+		}
+	};
+}